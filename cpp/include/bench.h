@@ -0,0 +1,37 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#include "jsonparse.h"
+
+typedef struct BenchResult {
+    std::string scene;
+    std::string camera_path;
+    int warmup_iterations;
+    int iterations;
+    int path_frames;
+    int ods_width;
+    int ods_height;
+    int num_views;
+    std::vector<double> frame_ms; // latency of each measured frame
+    double total_s;               // wall time of all measured frames
+    std::vector<double> psnr;     // quality of frames with ground truth (first measured iteration)
+    std::vector<double> ws_psnr;
+} BenchResult;
+
+double bmPercentile(const std::vector<double>& sorted_values, double percentile);
+uint64_t bmPeakRssBytes();
+int bmWriteReport(const char *filename, const BenchResult& result);
+void bmPrintReport(const BenchResult& result);
+
+#endif // BENCH_H
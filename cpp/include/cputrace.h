@@ -0,0 +1,39 @@
+#ifndef CPUTRACE_H
+#define CPUTRACE_H
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define CPU_TRACE_MAX_EVENTS 1000000
+
+typedef struct CpuTraceEvent {
+    std::string name;
+    uint32_t tid;
+    int64_t start_us;
+    int64_t duration_us;
+} CpuTraceEvent;
+
+// Records time from construction to destruction as a zone on calling thread
+class CpuTraceZone
+{
+public:
+    CpuTraceZone(const char *name);
+    ~CpuTraceZone();
+
+private:
+    const char *name;
+    int64_t start_us;
+};
+
+void ctStartTrace();
+void ctSetThreadName(const char *name);
+void ctRecordZone(const char *name, int64_t start_us, int64_t end_us);
+int64_t ctNow();
+int ctWriteTrace(const char *filename);
+
+static uint32_t ctThreadId();
+
+#endif // CPUTRACE_H
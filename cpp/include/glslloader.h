@@ -1,21 +1,68 @@
 #ifndef GLSL_LOADER_H
 #define GLSL_LOADER_H
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 #include "glad/gl.h"
 #include <GLFW/glfw3.h>
 
+#define SHADER_RELOAD_INTERVAL_MS 250
+
 namespace glsl {
-    GLuint createShaderProgram(const char *vert_filename, const char *frag_filename);
+    // `defines` ("NAME" or "NAME VALUE") and then contents of `headers` (GLSL files with declarations shared by
+    // several programs) are inserted after each shader's #version line
+    GLuint createShaderProgram(const char *vert_filename, const char *frag_filename,
+                               const std::vector<std::string>& defines = std::vector<std::string>(),
+                               const std::vector<std::string>& headers = std::vector<std::string>());
+    GLuint createShaderProgram(const char *vert_filename, const char *geom_filename, const char *frag_filename,
+                               const std::vector<std::string>& defines = std::vector<std::string>(),
+                               const std::vector<std::string>& headers = std::vector<std::string>());
+    GLuint createComputeProgram(const char *comp_filename,
+                                const std::vector<std::string>& defines = std::vector<std::string>(),
+                                const std::vector<std::string>& headers = std::vector<std::string>());
     void linkShaderProgram(GLuint program);
     void getShaderProgramUniforms(GLuint program, std::map<std::string,GLint>& uniforms);
+    void setProgramCacheDirectory(const char *directory);
+    void printCompileTimes();
+    int reloadChangedPrograms(std::vector<std::pair<GLuint,GLuint>>& reloaded);
 
     static GLint compileShader(char *source, int32_t length, GLenum type);
     static GLuint attachShaders(GLuint shaders[], uint16_t num_shaders);
     static std::string shaderTypeToString(GLenum type);
     static int32_t readFile(const char* filename, char** data_ptr);
+    static int readHeaders(const std::vector<std::string>& headers, std::string& text);
+    static void injectPreamble(char **source, int32_t *length, const std::vector<std::string>& defines,
+                               const std::string& header);
+    static void beginCompileTime(GLuint program, const char *filenames[], uint16_t num_files,
+                                 const std::vector<std::string>& defines, const std::vector<std::string>& headers,
+                                 std::chrono::steady_clock::time_point start, bool binary);
+    static uint64_t programKey(char *sources[], int32_t lengths[], uint16_t num_sources);
+    static GLuint loadProgramBinary(uint64_t key);
+    static void saveProgramBinary(GLuint program, uint64_t key);
+    static std::string programBinaryFilename(uint64_t key);
+    static GLuint createProgram(const std::vector<std::string>& filenames, const std::vector<std::string>& defines,
+                                const std::vector<std::string>& headers);
+    static std::vector<std::string> programFiles(GLuint program);
+    static void deleteProgram(GLuint program);
+    static std::set<std::string> changedShaderFiles();
 }
 
 #endif // GLSL_LOADER_H
@@ -0,0 +1,43 @@
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "glad/gl.h"
+
+typedef struct GpuTimerSample {
+    uint32_t frame;
+    std::string zone;
+    double ms;
+} GpuTimerSample;
+
+typedef struct GpuTimer {
+    bool enabled;
+    uint32_t frame;
+    // Ring of GL_TIME_ELAPSED queries (results collected once available, never waited on while running)
+    std::vector<GLuint> queries;
+    std::vector<std::string> zones;
+    std::vector<uint32_t> frames;
+    int head;
+    int count;
+    bool zone_open;
+    uint32_t dropped;
+    std::vector<GpuTimerSample> samples;
+} GpuTimer;
+
+void gtCreateTimer(GpuTimer *timer, int ring_size);
+void gtDestroyTimer(GpuTimer *timer);
+void gtBeginZone(GpuTimer *timer, const std::string& zone);
+void gtEndZone(GpuTimer *timer);
+void gtEndFrame(GpuTimer *timer);
+void gtFinish(GpuTimer *timer);
+int gtWriteCsv(GpuTimer *timer, const char *filename);
+int gtWriteJson(GpuTimer *timer, const char *filename);
+void gtPrintSummary(GpuTimer *timer);
+
+static void gtCollect(GpuTimer *timer, bool wait);
+
+#endif // GPUTIMER_H
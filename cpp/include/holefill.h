@@ -0,0 +1,17 @@
+#ifndef HOLEFILL_H
+#define HOLEFILL_H
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "cputrace.h"
+
+int hfFillHoles(uint8_t *color, float *depth, int width, int height, int num_eyes, float empty_depth, int radius,
+                int num_threads);
+
+static int hfFillRows(const uint8_t *src_color, const float *src_depth, uint8_t *dst_color, float *dst_depth,
+                      int width, int height, int row_start, int row_end, float empty_depth, int radius);
+
+#endif // HOLEFILL_H
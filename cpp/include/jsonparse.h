@@ -0,0 +1,35 @@
+#ifndef JSONPARSE_H
+#define JSONPARSE_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+enum JsonType {JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT};
+
+typedef struct JsonValue {
+    JsonType type;
+    bool boolean;
+    double number;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string,JsonValue> object;
+} JsonValue;
+
+int jsonParse(const char *text, JsonValue *value);
+int jsonParseFile(const char *filename, JsonValue *value);
+const JsonValue* jsonGetMember(const JsonValue& object, const char *key);
+double jsonGetNumber(const JsonValue& object, const char *key, double default_value);
+bool jsonGetBool(const JsonValue& object, const char *key, bool default_value);
+std::string jsonGetString(const JsonValue& object, const char *key, const std::string& default_value);
+int jsonGetVec3(const JsonValue& object, const char *key, float *vec);
+void jsonWriteString(FILE *fp, const std::string& value);
+
+static const char* jsonParseValue(const char *text, JsonValue *value);
+static const char* jsonParseString(const char *text, std::string *string);
+static const char* jsonSkipWhitespace(const char *text);
+
+#endif // JSONPARSE_H
@@ -0,0 +1,79 @@
+#ifndef ODSARCHIVE_H
+#define ODSARCHIVE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "tilecodec.h"
+
+#define ODS_ARCHIVE_MAGIC "CDEPARC"
+#define ODS_ARCHIVE_VERSION 1
+#define ODS_ARCHIVE_ALIGNMENT 4096
+
+enum OdsArchiveEncoding {OA_ENCODING_RAW = 0, OA_ENCODING_TLZ = 1};
+
+// On-disk layout (little endian): header, view table, then page aligned color and depth payloads
+typedef struct OdsArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_views;
+    uint32_t alignment;
+    uint32_t reserved[3];
+} OdsArchiveHeader;
+
+typedef struct OdsArchiveView {
+    float position[3];
+    uint32_t width;
+    uint32_t height;
+    uint32_t color_encoding; // RGBA8 (raw or TLZ tiles)
+    uint32_t depth_encoding; // 32-bit float distance (raw or TLZ tiles)
+    uint32_t reserved;
+    uint64_t color_offset;
+    uint64_t color_size;
+    uint64_t depth_offset;
+    uint64_t depth_size;
+} OdsArchiveView;
+
+typedef struct OdsArchive {
+    const uint8_t *data;
+    uint64_t size;
+    std::vector<OdsArchiveView> views;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int file;
+#endif
+} OdsArchive;
+
+typedef struct OdsArchiveWriter {
+    FILE *fp;
+    uint64_t offset;
+    std::vector<OdsArchiveView> views;
+    uint32_t num_views;
+} OdsArchiveWriter;
+
+int oaOpenArchive(const char *filename, OdsArchive *archive);
+void oaCloseArchive(OdsArchive *archive);
+int oaReadView(const OdsArchive *archive, int view, int num_threads, const uint8_t **color, const float **depth,
+               std::vector<uint8_t> *scratch);
+int oaBeginArchive(const char *filename, uint32_t num_views, OdsArchiveWriter *writer);
+int oaAddView(OdsArchiveWriter *writer, const float *position, uint32_t width, uint32_t height, const uint8_t *color,
+              const float *depth, bool compress);
+int oaFinishArchive(OdsArchiveWriter *writer);
+
+static int oaValidPayload(const OdsArchive *archive, uint64_t offset, uint64_t size, uint32_t encoding,
+                          const OdsArchiveView& view, TlzFormat format);
+static int oaWritePayload(OdsArchiveWriter *writer, const void *data, uint64_t size, uint64_t *offset);
+
+#endif // ODSARCHIVE_H
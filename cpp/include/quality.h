@@ -0,0 +1,35 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define QM_MAX_PSNR 99.0 // reported for identical images (keeps results finite)
+
+typedef struct QualityResult {
+    double psnr;          // dB over non-black pixels of test image
+    double ws_psnr;       // dB with each pixel weighted by its solid angle (latitude weighted)
+    uint64_t valid_pixels;
+} QualityResult;
+
+typedef struct QualitySums {
+    uint64_t sq_err;
+    double weighted_sq_err;
+    uint64_t valid_pixels;
+    double valid_weight;
+} QualitySums;
+
+int qmComparePanoramas(const uint8_t *test, const uint8_t *truth, int width, int height, int num_eyes, int channels,
+                       int num_threads, QualityResult *result);
+
+static void qmAccumulateRows(const uint8_t *test, const uint8_t *truth, int width, int height, int channels,
+                             int row_start, int row_end, QualitySums *sums);
+template <int CHANNELS>
+static void qmAccumulateRow(const uint8_t *test_row, const uint8_t *truth_row, int width, uint64_t *sq_err,
+                            uint64_t *valid);
+static double qmRowWeight(int row, int height, int width);
+
+#endif // QUALITY_H
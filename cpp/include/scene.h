@@ -0,0 +1,50 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "imageio.h"
+#include "jsonparse.h"
+#include "tilecodec.h"
+
+enum SceneColorEncoding {SCENE_COLOR_PNG, SCENE_COLOR_TLZ};
+enum SceneDepthEncoding {SCENE_DEPTH_FLOAT, SCENE_DEPTH_RVL};
+
+typedef struct SceneImage {
+    std::string file_prefix; // <prefix>.png (or .tlz) color and <prefix>.depth (or .rvl) depth
+    float position[3];
+} SceneImage;
+
+typedef struct SceneManifest {
+    std::string name;
+    std::string format;      // "dasp" (left and right image per view) or "cdep" (one image per view)
+    int num_views;
+    int max_views;
+    float dasp_ipd;
+    float dasp_focal_dist;
+    float near;
+    float far;
+    SceneColorEncoding color_encoding; // "png" (<prefix>.png) or "tlz" (<prefix>.tlz)
+    SceneDepthEncoding depth_encoding; // "float" (<prefix>.depth) or "rvl" (<prefix>.rvl)
+    float center[3];         // default synthesized position
+    std::vector<SceneImage> images;
+    std::string archive;     // optional packed archive holding all images (in order of 'images')
+    bool stream_tiles;       // upload archive tiles only once they may project into viewport (needs TLZ archive)
+} SceneManifest;
+
+typedef struct CameraPathFrame {
+    float position[3];
+    float yaw;
+    float pitch;
+    std::string truth_image; // optional ground truth ODS image (for quality metrics)
+} CameraPathFrame;
+
+int scnLoadManifest(const char *filename, SceneManifest *scene);
+void scnGetImageFilenames(const SceneManifest& scene, int image, std::string *color_filename,
+                          std::string *depth_filename);
+int scnReadImage(const SceneManifest& scene, int image, int num_threads, uint8_t **color, float **depth, int *width,
+                 int *height);
+int scnLoadCameraPath(const char *filename, std::vector<CameraPathFrame> *path);
+
+#endif // SCENE_H
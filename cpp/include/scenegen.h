@@ -0,0 +1,59 @@
+#ifndef SCENEGEN_H
+#define SCENEGEN_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+#include "imageio.h"
+#include "jsonparse.h"
+
+enum SceneGenType {SCENEGEN_SPHERES, SCENEGEN_ROOM, SCENEGEN_OCCLUDERS};
+
+typedef struct SceneGenOptions {
+    SceneGenType type;
+    std::string name;
+    std::string output_dir;
+    int width;               // panorama width (height is half)
+    int num_views;
+    float center[3];         // center of view volume (and default synthesized position)
+    float view_extent[3];    // half size of box containing captured views
+    int num_occluders;
+    uint32_t seed;
+    int num_threads;
+} SceneGenOptions;
+
+typedef struct SgVec3 {
+    float x;
+    float y;
+    float z;
+} SgVec3;
+
+typedef struct SgPrimitive {
+    int type;                // 0: sphere, 1: box, 2: room (inside of box), 3: floor plane (y = 0), 4: sky (inside of sphere)
+    SgVec3 a;                // sphere center or box min
+    SgVec3 b;                // sphere radius (x) or box max
+    SgVec3 color;
+} SgPrimitive;
+
+int sgGenerateScene(const SceneGenOptions& options);
+
+static SgVec3 sgVec3(float x, float y, float z);
+static float sgRandom(std::mt19937& rng, float min, float max);
+static void sgBuildScene(const SceneGenOptions& options, std::vector<SgPrimitive>& primitives);
+static void sgRenderRows(const std::vector<SgPrimitive>& primitives, SgVec3 origin, int width, int height,
+                         int row_start, int row_end, uint8_t *color, float *depth);
+static float sgTrace(const std::vector<SgPrimitive>& primitives, SgVec3 origin, SgVec3 dir, SgVec3 *color);
+static int sgWriteManifest(const SceneGenOptions& options, const std::vector<SgVec3>& positions);
+static int sgWriteCameraPath(const SceneGenOptions& options);
+
+#endif // SCENEGEN_H
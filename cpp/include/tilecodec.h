@@ -0,0 +1,53 @@
+#ifndef TILECODEC_H
+#define TILECODEC_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "imageio.h"
+
+#define TLZ_MAGIC "TLZ\n"
+#define TLZ_VERSION 2
+#define TLZ_DEFAULT_TILE_SIZE 256
+
+enum TlzFormat {TLZ_FORMAT_RGBA8 = 0, TLZ_FORMAT_R32F = 1};
+
+// Tiled image: header, tile table, then tiles (rows of tile's pixels, LZ4 block compressed or stored raw). Tiles can
+// be decoded on their own, so parts of an image can be loaded without touching the rest
+typedef struct TlzHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t tile_size;
+    uint32_t tiles_x;
+    uint32_t tiles_y;
+} TlzHeader;
+
+typedef struct TlzTile {
+    uint64_t offset;   // from start of image
+    uint32_t size;     // compressed bytes (equal to raw size when tile is stored uncompressed)
+    uint32_t reserved;
+    float value_range[2]; // min and max value of R32F tiles (e.g. depth range), zero for RGBA8 tiles
+} TlzTile;
+
+int tcEncodeImage(const uint8_t *pixels, int width, int height, TlzFormat format, int tile_size,
+                  std::vector<uint8_t> *output);
+int tcReadHeader(const uint8_t *data, uint64_t size, TlzHeader *header);
+int tcDecodeImage(const uint8_t *data, uint64_t size, int num_threads, uint8_t *pixels);
+int tcDecodeTile(const uint8_t *data, const TlzHeader& header, int tile, uint8_t *pixels);
+const TlzTile* tcGetTiles(const uint8_t *data);
+void tcGetTileRect(const TlzHeader& header, int tile, int *x, int *y, int *w, int *h);
+uint8_t* tcReadImage(const char *filename, int num_threads, int *width, int *height, TlzFormat *format);
+
+static void tcDecodeTiles(const uint8_t *data, const TlzHeader& header, int first_tile, int tile_stride,
+                          uint8_t *pixels, int *success);
+static int tcCompressBlock(const uint8_t *src, int src_size, uint8_t *dst, int dst_capacity);
+static int tcDecompressBlock(const uint8_t *src, int src_size, uint8_t *dst, int dst_size);
+
+#endif // TILECODEC_H
@@ -0,0 +1,25 @@
+#ifndef VIEWCACHE_H
+#define VIEWCACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+#include "imageio.h"
+#include "odsarchive.h"
+#include "scene.h"
+
+#define VIEW_CACHE_VERSION 1
+
+int vcOpenView(const char *cache_dir, bool compress, const SceneManifest& scene, int image, int num_threads,
+               OdsArchive *entry, uint8_t **color, float **depth, int *width, int *height);
+
+static int vcHashFile(const char *filename, uint64_t *hash);
+static int vcMakeDirectories(const std::string& path);
+
+#endif // VIEWCACHE_H
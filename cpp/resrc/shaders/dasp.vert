@@ -4,6 +4,7 @@ precision highp float;
 
 #define M_PI 3.1415926535897932384626433832795
 #define EPSILON 0.000001
+#define EMPTY_DEPTH 1000.0
 
 uniform float img_ipd;
 uniform float img_focal_dist;
@@ -13,10 +14,13 @@ uniform float camera_ipd;
 uniform float camera_focal_dist;
 uniform float camera_eye; // left: +1.0, right: -1.0
 uniform mat4 ortho_projection;
+uniform vec2 texture_scale;
+uniform vec2 texture_offset;
+uniform float edge_threshold; // relative depth change that marks a sample as low confidence (0.0: disabled)
 uniform sampler2D depths;
 
-in vec2 vertex_position;
-in vec2 vertex_texcoord;
+layout(location = 0) in vec2 vertex_position;
+layout(location = 1) in vec2 vertex_texcoord;
 
 out vec2 texcoord;
 out float pt_depth;
@@ -37,7 +41,8 @@ void main() {
                        0.0);
 
     // Calculate 3D position of point (relative to projection sphere center)
-    float vertex_depth = texture(depths, vertex_texcoord).r;
+    vec2 img_texcoord = vertex_texcoord * texture_scale + texture_offset;
+    float vertex_depth = texture(depths, img_texcoord).r;
     vec3 pt = eye_pt + (vertex_depth * normalize(projected_pt - eye_pt));
 
     // Backproject to new ODS panorama
@@ -72,11 +77,24 @@ void main() {
     // float size_scale = 1.1 + (0.4 - (0.16 * min(camera_distance, 2.5))); // scale ranges from 1.1 to 1.5
     // gl_PointSize = size_scale * size_ratio;
 
+    // Discard empty samples and samples along depth discontinuities (move outside view volume)
+    float discard_pt = float(vertex_depth >= EMPTY_DEPTH);
+    if (edge_threshold > 0.0) {
+        float depth_l = textureOffset(depths, img_texcoord, ivec2(-1, 0)).r;
+        float depth_r = textureOffset(depths, img_texcoord, ivec2( 1, 0)).r;
+        float depth_b = textureOffset(depths, img_texcoord, ivec2( 0,-1)).r;
+        float depth_t = textureOffset(depths, img_texcoord, ivec2( 0, 1)).r;
+        float depth_min = min(min(depth_l, depth_r), min(depth_b, depth_t));
+        float depth_max = max(max(depth_l, depth_r), max(depth_b, depth_t));
+        discard_pt += float(max(depth_max - vertex_depth, vertex_depth - depth_min) > edge_threshold * vertex_depth);
+    }
+    projected_azimuth -= float(discard_pt > 0.0) * 10.0;
+
     // Set point position
     float depth_hint = 0.0075 * eye; // favor left eye image when depth's match
     gl_Position = ortho_projection * vec4(projected_azimuth, projected_inclination, -camera_distance + depth_hint, 1.0);
 
     // Pass along texture coordinate and depth
-    texcoord = vertex_texcoord;
+    texcoord = img_texcoord;
     pt_depth = camera_distance;
 }
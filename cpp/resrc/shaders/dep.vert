@@ -5,24 +5,33 @@ precision highp float;
 #define M_PI 3.1415926535897932384626433832795
 #define EPSILON 0.000001
 
-uniform float img_index;
-uniform vec3 camera_position;
-uniform float camera_ipd;
-uniform float camera_focal_dist;
+// CAMERA_EYE, UNIT_POINT_SIZE and HIZ_CULLING may be defined when compiling to specialize program (otherwise uniforms)
+#ifndef CAMERA_EYE
 uniform float camera_eye; // left: +1.0, right: -1.0
-uniform float xr_fovy;
-uniform float xr_aspect;
-uniform vec3 xr_view_dir;
-uniform mat4 ortho_projection;
+#define CAMERA_EYE camera_eye
+#endif
+uniform int foveation_region; // 0: XR viewport, 1: periphery, 2: behind viewer
+uniform float point_size_scale;
+#ifndef UNIT_POINT_SIZE
+uniform bool unit_point_size; // splat 1 pixel points (gaps filled by pull-push)
+#define UNIT_POINT_SIZE unit_point_size
+#endif
 uniform sampler2D depths;
+#ifndef HIZ_CULLING
+uniform bool hiz_culling; // cull points behind previous frame's surfaces
+#define HIZ_CULLING hiz_culling
+#endif
 
-in vec2 vertex_position;
-in vec2 vertex_texcoord;
+layout(location = 0) in vec2 vertex_position;
+layout(location = 1) in vec2 vertex_texcoord;
+layout(location = 3) in uint draw_id; // instanced attribute (base instance of draw command)
 
 out vec2 texcoord;
 out float pt_depth;
 
 void main() {
+    ViewParams view = views[draw_id];
+
     // Calculate projected point position (relative to projection sphere center)
     float azimuth = vertex_position.x;
     float inclination = vertex_position.y;
@@ -33,7 +42,7 @@ void main() {
                    vertex_depth * cos(inclination));
 
     // Backproject to new ODS panorama
-    vec3 camera_spherical = vec3(camera_position.z, camera_position.x, camera_position.y);
+    vec3 camera_spherical = vec3(view.camera_position.z, view.camera_position.x, view.camera_position.y);
     vec3 vertex_direction = pt - camera_spherical;
     float magnitude = length(vertex_direction);
     float center_azimuth = (abs(vertex_direction.x) < EPSILON && abs(vertex_direction.y) < EPSILON) ?
@@ -42,7 +51,7 @@ void main() {
     float center_inclination = acos(vertex_direction.z / magnitude);
 
     float camera_radius = 0.5 * camera_ipd * cos(center_inclination - (M_PI / 2.0));
-    float camera_azimuth = center_azimuth + camera_eye * acos(camera_radius / magnitude);
+    float camera_azimuth = center_azimuth + CAMERA_EYE * acos(camera_radius / magnitude);
     vec3 camera_pt = vec3(camera_radius * cos(camera_azimuth),
                           camera_radius * sin(camera_azimuth),
                           0.0);
@@ -60,7 +69,8 @@ void main() {
     //gl_PointSize = 1.0;
     float size_ratio = vertex_depth / camera_distance;
     float size_scale = 1.1 + (0.4 - (0.16 * min(camera_distance, 2.5))); // scale ranges from 1.1 to 1.5
-    gl_PointSize = size_scale * size_ratio;
+    float point_size = UNIT_POINT_SIZE ? point_size_scale : point_size_scale * size_scale * size_ratio;
+    gl_PointSize = point_size;
 
     // XR viewport only
     float diag_aspect = sqrt(xr_aspect * xr_aspect + 1.0);
@@ -68,11 +78,17 @@ void main() {
     //float horizontal_fov = atan(tan(vertical_fov) * xr_aspect);
     float diagonal_fov = atan(tan(vertical_fov) * diag_aspect);
     vec3 point_dir = normalize(img_sphere_pt.yzx);
-    // discard point (move outside view volume) if angle between point direction and view diretion > diagonal FOV
-    projected_azimuth -= float(dot(point_dir, xr_view_dir) < cos(diagonal_fov)) * 10.0;
+    float view_cos = dot(point_dir, xr_view_dir);
+    int pt_region = (view_cos >= cos(diagonal_fov)) ? 0 : ((view_cos >= cos(foveation_behind_angle)) ? 1 : 2);
+    // discard point (move outside view volume) if it is not in the region currently being synthesized
+    // or if it is hidden behind previous frame's surfaces or lands in a region already filled by nearer views
+    vec2 out_px = vec2(float(textureSize(hiz_depth, 0).x) * ((2.0 * M_PI) - projected_azimuth) / (2.0 * M_PI),
+                       float(textureSize(hiz_depth, 0).y / 2) * (((M_PI - projected_inclination) / M_PI) + step(0.0, CAMERA_EYE)));
+    bool occluded = (HIZ_CULLING && hizOccluded(out_px, point_size, camera_distance)) || regionFilled(out_px);
+    projected_azimuth -= float(pt_region != foveation_region || occluded) * 10.0;
 
     // Set point position
-    float depth_hint = 0.015 * img_index; // favor image with lower index when depth's match (index should be based on dist)
+    float depth_hint = 0.015 * view.img_index; // favor image with lower index when depth's match (index should be based on dist)
     gl_Position = ortho_projection * vec4(projected_azimuth, projected_inclination, -camera_distance - depth_hint, 1.0);
 
     // Pass along texture coordinate and depth
@@ -0,0 +1,56 @@
+// Declarations shared by DEP programs (inserted after #version by glsl loader, so no #version here)
+// Blocks must match layout of OdsViewParams and OdsFrameParams in main.cpp
+
+struct ViewParams {
+    vec3 camera_position;
+    float img_index;
+    int layer;
+    int padding[3];
+};
+
+layout(std430, binding = 0) readonly buffer ViewParamsBuffer {
+    ViewParams views[];
+};
+
+// Frame constants (updated once per frame)
+layout(std140, binding = 0) uniform FrameParams {
+    mat4 ortho_projection;
+    vec3 xr_view_dir;
+    float camera_ipd;
+    float camera_focal_dist;
+    float xr_fovy;
+    float xr_aspect;
+    float foveation_behind_angle;
+};
+
+uniform float hiz_tolerance;
+uniform int hiz_max_level;
+uniform sampler2D hiz_depth;
+uniform ivec2 region_grid; // regions per eye in output image
+uniform uint filled_regions[2]; // bit mask of regions already filled by nearer views
+
+// Conservative occlusion test against max-depth pyramid of previous frame (reprojected to current position)
+bool hizOccluded(vec2 px, float size, float distance) {
+    ivec2 dims = textureSize(hiz_depth, 0);
+    vec2 px_min = px - vec2(0.5 * size);
+    vec2 px_max = px + vec2(0.5 * size);
+    if (px_min.x < 0.0 || px_max.x > float(dims.x)) {
+        return false; // footprint wraps around azimuth seam
+    }
+    // Footprint covers at most 2x2 texels of level whose texels are at least as large as the point
+    int level = clamp(int(ceil(log2(max(size, 1.0)))), 0, hiz_max_level);
+    ivec2 level_max = textureSize(hiz_depth, level) - 1;
+    ivec2 t_min = clamp(ivec2(floor(px_min)) >> level, ivec2(0), level_max);
+    ivec2 t_max = clamp(ivec2(floor(px_max)) >> level, ivec2(0), level_max);
+    float max_depth = max(max(texelFetch(hiz_depth, t_min, level).r, texelFetch(hiz_depth, ivec2(t_max.x, t_min.y), level).r),
+                          max(texelFetch(hiz_depth, ivec2(t_min.x, t_max.y), level).r, texelFetch(hiz_depth, t_max, level).r));
+    return distance > max_depth * (1.0 + hiz_tolerance);
+}
+
+// Whether region of output image containing pixel was already filled by nearer views
+bool regionFilled(vec2 px) {
+    ivec2 dims = textureSize(hiz_depth, 0) / ivec2(1, 2);
+    ivec2 cell = clamp(ivec2(px * vec2(region_grid) / vec2(dims)), ivec2(0), ivec2(region_grid.x - 1, 2 * region_grid.y - 1));
+    int region = cell.y * region_grid.x + cell.x;
+    return (filled_regions[region / 32] & (1u << uint(region % 32))) != 0u;
+}
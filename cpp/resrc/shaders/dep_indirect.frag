@@ -0,0 +1,17 @@
+#version 430
+
+precision mediump float;
+
+in vec2 texcoord;
+in float pt_depth;
+flat in int img_layer;
+
+layout(binding = 0) uniform sampler2DArray image;
+
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out float FragDepth;
+
+void main() {
+    FragColor = texture(image, vec3(texcoord, float(img_layer)));
+    FragDepth = pt_depth;
+}
@@ -0,0 +1,46 @@
+#version 430
+
+precision highp float;
+
+#define M_PI 3.1415926535897932384626433832795
+#define EPSILON 0.000001
+
+uniform sampler2D depths;
+
+layout(location = 0) in vec2 vertex_position;
+layout(location = 1) in vec2 vertex_texcoord;
+layout(location = 3) in uint draw_id; // instanced attribute (base instance of draw command)
+
+out vec3 vertex_direction;
+out float center_azimuth;
+out float camera_radius;
+out float vertex_depth;
+out vec2 pt_texcoord;
+out float view_img_index;
+
+void main() {
+    ViewParams view = views[draw_id];
+
+    // Calculate projected point position (relative to projection sphere center)
+    float azimuth = vertex_position.x;
+    float inclination = vertex_position.y;
+
+    vertex_depth = texture(depths, vertex_texcoord).r;
+    vec3 pt = vec3(vertex_depth * cos(azimuth) * sin(inclination),
+                   vertex_depth * sin(azimuth) * sin(inclination),
+                   vertex_depth * cos(inclination));
+
+    // Backproject to new ODS panorama (part shared by both eyes)
+    vec3 camera_spherical = vec3(view.camera_position.z, view.camera_position.x, view.camera_position.y);
+    vertex_direction = pt - camera_spherical;
+    float magnitude = length(vertex_direction);
+    center_azimuth = (abs(vertex_direction.x) < EPSILON && abs(vertex_direction.y) < EPSILON) ?
+                     (1.0 - 0.5 * sign(vertex_direction.z)) * M_PI :
+                     atan(vertex_direction.y, vertex_direction.x);
+    float center_inclination = acos(vertex_direction.z / magnitude);
+    camera_radius = 0.5 * camera_ipd * cos(center_inclination - (M_PI / 2.0));
+
+    // Pass along texture coordinate and view
+    pt_texcoord = vertex_texcoord;
+    view_img_index = view.img_index;
+}
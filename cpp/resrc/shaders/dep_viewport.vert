@@ -0,0 +1,64 @@
+#version 430
+
+precision highp float;
+
+#define M_PI 3.1415926535897932384626433832795
+#define EPSILON 0.000001
+
+uniform float img_index;
+uniform vec3 camera_position;
+uniform float camera_ipd;
+uniform float camera_eye; // left: +1.0, right: -1.0
+uniform float pixel_scale; // viewport pixels per ODS image pixel
+uniform mat4 modelview;
+uniform mat4 projection;
+uniform sampler2D depths;
+
+layout(location = 0) in vec2 vertex_position;
+layout(location = 1) in vec2 vertex_texcoord;
+
+out vec2 texcoord;
+out float pt_depth;
+
+void main() {
+    // Calculate projected point position (relative to projection sphere center)
+    float azimuth = vertex_position.x;
+    float inclination = vertex_position.y;
+
+    float vertex_depth = texture(depths, vertex_texcoord).r;
+    vec3 pt = vec3(vertex_depth * cos(azimuth) * sin(inclination),
+                   vertex_depth * sin(azimuth) * sin(inclination),
+                   vertex_depth * cos(inclination));
+
+    // Find ODS eye position for point (relative to synthesized camera)
+    vec3 camera_spherical = vec3(camera_position.z, camera_position.x, camera_position.y);
+    vec3 vertex_direction = pt - camera_spherical;
+    float magnitude = length(vertex_direction);
+    float center_azimuth = (abs(vertex_direction.x) < EPSILON && abs(vertex_direction.y) < EPSILON) ?
+                           (1.0 - 0.5 * sign(vertex_direction.z)) * M_PI :
+                           atan(vertex_direction.y, vertex_direction.x);
+    float center_inclination = acos(vertex_direction.z / magnitude);
+
+    float camera_radius = 0.5 * camera_ipd * cos(center_inclination - (M_PI / 2.0));
+    float camera_azimuth = center_azimuth + camera_eye * acos(camera_radius / magnitude);
+    vec3 camera_pt = vec3(camera_radius * cos(camera_azimuth),
+                          camera_radius * sin(camera_azimuth),
+                          0.0);
+    vec3 camera_to_pt = vertex_direction - camera_pt;
+    float camera_distance = length(camera_to_pt);
+    vec3 camera_ray = camera_to_pt / camera_distance;
+
+    // Set point size (relative to ODS image pixel size)
+    float size_ratio = vertex_depth / camera_distance;
+    float size_scale = 1.1 + (0.4 - (0.16 * min(camera_distance, 2.5))); // scale ranges from 1.1 to 1.5
+    gl_PointSize = max(pixel_scale * size_scale * size_ratio, 1.0);
+
+    // Project directly into perspective view (push point back along its ray to favor image with lower index)
+    float depth_hint = 0.015 * img_index;
+    vec3 view_pt = (camera_distance + depth_hint) * camera_ray.yzx;
+    gl_Position = projection * modelview * vec4(view_pt, 1.0);
+
+    // Pass along texture coordinate and depth
+    texcoord = vertex_texcoord;
+    pt_depth = camera_distance;
+}
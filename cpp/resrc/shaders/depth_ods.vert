@@ -6,8 +6,8 @@ uniform mat4 modelview;
 uniform mat4 projection;
 
 
-in vec3 vertex_position;
-in vec2 vertex_texcoord;
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_texcoord;
 
 out vec3 position;
 out vec2 texcoord;
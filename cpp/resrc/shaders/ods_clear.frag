@@ -0,0 +1,35 @@
+#version 430
+
+precision highp float;
+
+#define M_PI 3.1415926535897932384626433832795
+#define EMPTY_DEPTH 1000.0
+
+uniform int clear_regions; // bit mask - 1: XR viewport, 2: periphery, 4: behind viewer
+uniform vec2 viewport_origin;
+uniform vec2 viewport_size;
+
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out float FragDepth;
+
+void main() {
+    // Direction of ODS pixel
+    vec2 px = (gl_FragCoord.xy - viewport_origin) / viewport_size;
+    float azimuth = 2.0 * M_PI * (1.0 - px.x);
+    float inclination = M_PI * (1.0 - px.y);
+    vec3 pixel_dir = vec3(sin(inclination) * sin(azimuth), cos(inclination), sin(inclination) * cos(azimuth));
+
+    // Only clear pixels in regions being re-synthesized (same classification as DEP shader)
+    float diag_aspect = sqrt(xr_aspect * xr_aspect + 1.0);
+    float vertical_fov = 0.5 * xr_fovy + 0.005;
+    float diagonal_fov = atan(tan(vertical_fov) * diag_aspect);
+    float view_cos = dot(pixel_dir, xr_view_dir);
+    int px_region = (view_cos >= cos(diagonal_fov)) ? 0 : ((view_cos >= cos(foveation_behind_angle)) ? 1 : 2);
+    if ((clear_regions & (1 << px_region)) == 0) {
+        discard;
+    }
+
+    FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+    FragDepth = EMPTY_DEPTH;
+    gl_FragDepth = 1.0;
+}
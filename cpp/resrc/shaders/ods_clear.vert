@@ -0,0 +1,9 @@
+#version 430
+
+precision highp float;
+
+void main() {
+    // Full screen triangle (no vertex attributes)
+    vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2)) * 2.0 - 1.0;
+    gl_Position = vec4(position, 0.0, 1.0);
+}
@@ -0,0 +1,8 @@
+#version 430
+
+precision highp float;
+
+void main() {
+    // Passes depth test (less or equal) only where nothing has been drawn since clear
+    gl_FragDepth = 1.0;
+}
@@ -7,9 +7,9 @@ uniform mat4 view;
 uniform mat4 projection;
 
 
-in vec3 vertex_position;
-in vec2 vertex_texcoord;
-in vec3 vertex_normal;
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_texcoord;
+layout(location = 2) in vec3 vertex_normal;
 
 out vec3 position;
 out vec2 texcoord;
@@ -0,0 +1,106 @@
+#include "bench.h"
+
+// Linear interpolation between closest ranks (percentile in [0, 100])
+double bmPercentile(const std::vector<double>& sorted_values, double percentile)
+{
+    if (sorted_values.empty())
+    {
+        return 0.0;
+    }
+    double rank = (percentile / 100.0) * (sorted_values.size() - 1);
+    size_t lower = (size_t)rank;
+    size_t upper = std::min(lower + 1, sorted_values.size() - 1);
+    return sorted_values[lower] + (rank - lower) * (sorted_values[upper] - sorted_values[lower]);
+}
+
+uint64_t bmPeakRssBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss;         // bytes
+#else
+    return usage.ru_maxrss * 1024;  // kilobytes
+#endif
+#endif
+}
+
+int bmWriteReport(const char *filename, const BenchResult& result)
+{
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", filename);
+        return 0;
+    }
+
+    std::vector<double> sorted_ms = result.frame_ms;
+    std::sort(sorted_ms.begin(), sorted_ms.end());
+    double mean_ms = 0.0;
+    for (size_t i = 0; i < sorted_ms.size(); i++)
+    {
+        mean_ms += sorted_ms[i];
+    }
+    mean_ms /= std::max(sorted_ms.size(), (size_t)1);
+    double fps = (result.total_s > 0.0) ? sorted_ms.size() / result.total_s : 0.0;
+    double mpix = 2.0 * result.ods_width * result.ods_height / 1.0e6;
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"scene\": ");
+    jsonWriteString(fp, result.scene);
+    fprintf(fp, ",\n  \"camera_path\": ");
+    jsonWriteString(fp, result.camera_path);
+    fprintf(fp, ",\n");
+    fprintf(fp, "  \"ods_width\": %d,\n", result.ods_width);
+    fprintf(fp, "  \"ods_height\": %d,\n", result.ods_height);
+    fprintf(fp, "  \"num_views\": %d,\n", result.num_views);
+    fprintf(fp, "  \"path_frames\": %d,\n", result.path_frames);
+    fprintf(fp, "  \"warmup_iterations\": %d,\n", result.warmup_iterations);
+    fprintf(fp, "  \"iterations\": %d,\n", result.iterations);
+    fprintf(fp, "  \"measured_frames\": %zu,\n", sorted_ms.size());
+    fprintf(fp, "  \"latency_ms\": {\"mean\": %.4lf, \"min\": %.4lf, \"p50\": %.4lf, \"p95\": %.4lf, \"p99\": %.4lf, \"max\": %.4lf},\n",
+            mean_ms, bmPercentile(sorted_ms, 0.0), bmPercentile(sorted_ms, 50.0), bmPercentile(sorted_ms, 95.0),
+            bmPercentile(sorted_ms, 99.0), bmPercentile(sorted_ms, 100.0));
+    fprintf(fp, "  \"throughput\": {\"frames_per_s\": %.4lf, \"megapixels_per_s\": %.4lf},\n", fps, fps * mpix);
+    if (!result.psnr.empty())
+    {
+        double psnr = 0.0;
+        double ws_psnr = 0.0;
+        for (size_t i = 0; i < result.psnr.size(); i++)
+        {
+            psnr += result.psnr[i];
+            ws_psnr += result.ws_psnr[i];
+        }
+        fprintf(fp, "  \"quality\": {\"frames\": %zu, \"psnr_db\": %.4lf, \"ws_psnr_db\": %.4lf},\n", result.psnr.size(),
+                psnr / result.psnr.size(), ws_psnr / result.ws_psnr.size());
+    }
+    fprintf(fp, "  \"peak_rss_bytes\": %llu\n", (unsigned long long)bmPeakRssBytes());
+    fprintf(fp, "}\n");
+    fclose(fp);
+    return 1;
+}
+
+void bmPrintReport(const BenchResult& result)
+{
+    std::vector<double> sorted_ms = result.frame_ms;
+    std::sort(sorted_ms.begin(), sorted_ms.end());
+    printf("%s: %zu frames, p50 %.3lf ms, p95 %.3lf ms, p99 %.3lf ms, %.2lf fps, peak RSS %.1lf MB\n",
+           result.scene.c_str(), sorted_ms.size(), bmPercentile(sorted_ms, 50.0), bmPercentile(sorted_ms, 95.0),
+           bmPercentile(sorted_ms, 99.0), (result.total_s > 0.0) ? sorted_ms.size() / result.total_s : 0.0,
+           bmPeakRssBytes() / (1024.0 * 1024.0));
+    for (size_t i = 0; i < result.psnr.size(); i++)
+    {
+        printf("  frame %zu: PSNR %.3lf dB, WS-PSNR %.3lf dB\n", i, result.psnr[i], result.ws_psnr[i]);
+    }
+}
@@ -0,0 +1,337 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <thread>
+#include "odsarchive.h"
+#include "quality.h"
+#include "scene.h"
+#include "scenegen.h"
+#include "tilecodec.h"
+
+void printUsage(const char *program);
+int runSceneGen(int argc, char **argv);
+int runQuality(int argc, char **argv);
+int runPack(int argc, char **argv);
+int runTlz(int argc, char **argv);
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::string command = argv[1];
+    if (command == "scenegen")
+    {
+        return runSceneGen(argc - 2, argv + 2);
+    }
+    else if (command == "quality")
+    {
+        return runQuality(argc - 2, argv + 2);
+    }
+    else if (command == "pack")
+    {
+        return runPack(argc - 2, argv + 2);
+    }
+    else if (command == "tlz")
+    {
+        return runTlz(argc - 2, argv + 2);
+    }
+
+    fprintf(stderr, "Error: unknown command '%s'\n", command.c_str());
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+}
+
+void printUsage(const char *program)
+{
+    fprintf(stderr, "Usage: %s <command> [arguments]\n", program);
+    fprintf(stderr, "Commands:\n");
+    fprintf(stderr, "  scenegen <spheres|room|occluders> <output_dir> [--name NAME] [--width W] [--views N]\n");
+    fprintf(stderr, "           [--occluders N] [--seed S] [--threads T]\n");
+    fprintf(stderr, "      Ray trace synthetic C-DEP panoramas (W x W/2) and write scene manifest and camera path\n");
+    fprintf(stderr, "  quality <test.png> <truth.png> [...]\n");
+    fprintf(stderr, "      PSNR and WS-PSNR of synthesized stereo ODS images (pairs of test and truth images)\n");
+    fprintf(stderr, "  pack <scene.json> <archive.cdepa> <packed_scene.json> [--compress]\n");
+    fprintf(stderr, "      Pack decoded color and depth of all scene images into one memory mappable archive\n");
+    fprintf(stderr, "      (optionally as LZ4 compressed tiles)\n");
+    fprintf(stderr, "  tlz <input.png> <output.tlz> [--tile T]\n");
+    fprintf(stderr, "      Convert image to tiled LZ4 format (use with scene \"color_encoding\": \"tlz\")\n");
+}
+
+int runSceneGen(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        printUsage("cdep_tool");
+        return EXIT_FAILURE;
+    }
+
+    SceneGenOptions options;
+    std::string type = argv[0];
+    if (type == "spheres")
+    {
+        options.type = SceneGenType::SCENEGEN_SPHERES;
+    }
+    else if (type == "room")
+    {
+        options.type = SceneGenType::SCENEGEN_ROOM;
+    }
+    else if (type == "occluders")
+    {
+        options.type = SceneGenType::SCENEGEN_OCCLUDERS;
+    }
+    else
+    {
+        fprintf(stderr, "Error: unknown scene type '%s'\n", type.c_str());
+        return EXIT_FAILURE;
+    }
+    options.output_dir = argv[1];
+    options.name = "synthetic_" + type;
+    options.width = 1024;
+    options.num_views = 8;
+    options.num_occluders = 24;
+    options.seed = 1;
+    options.num_threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    // View volume similar to captured office scene
+    options.center[0] = 0.0;
+    options.center[1] = 1.7;
+    options.center[2] = 0.0;
+    options.view_extent[0] = 0.35;
+    options.view_extent[1] = 0.15;
+    options.view_extent[2] = 0.175;
+
+    int i;
+    for (i = 2; i + 1 < argc; i += 2)
+    {
+        std::string flag = argv[i];
+        if (flag == "--name")
+        {
+            options.name = argv[i + 1];
+        }
+        else if (flag == "--width")
+        {
+            options.width = atoi(argv[i + 1]);
+        }
+        else if (flag == "--views")
+        {
+            options.num_views = atoi(argv[i + 1]);
+        }
+        else if (flag == "--occluders")
+        {
+            options.num_occluders = atoi(argv[i + 1]);
+        }
+        else if (flag == "--seed")
+        {
+            options.seed = strtoul(argv[i + 1], NULL, 10);
+        }
+        else if (flag == "--threads")
+        {
+            options.num_threads = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "Error: unknown option '%s'\n", flag.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    if (i < argc)
+    {
+        fprintf(stderr, "Error: option '%s' needs a value\n", argv[i]);
+        return EXIT_FAILURE;
+    }
+
+    return sgGenerateScene(options) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int runQuality(int argc, char **argv)
+{
+    if (argc < 2 || argc % 2 != 0)
+    {
+        printUsage("cdep_tool");
+        return EXIT_FAILURE;
+    }
+
+    int i;
+    int num_threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    double psnr = 0.0;
+    double ws_psnr = 0.0;
+    for (i = 0; i < argc; i += 2)
+    {
+        int test_width, test_height, truth_width, truth_height;
+        int test_channels = 4;
+        int truth_channels = 4;
+        uint8_t *test = iioReadImage(argv[i], &test_width, &test_height, &test_channels);
+        uint8_t *truth = iioReadImage(argv[i + 1], &truth_width, &truth_height, &truth_channels);
+        if (test == NULL || truth == NULL || test_width != truth_width || test_height != truth_height)
+        {
+            fprintf(stderr, "Error: could not read %s and %s as images of the same size\n", argv[i], argv[i + 1]);
+            return EXIT_FAILURE;
+        }
+
+        // Stereo ODS: left and right eye images stacked vertically
+        QualityResult result;
+        qmComparePanoramas(test, truth, test_width, test_height / 2, 2, 4, num_threads, &result);
+        iioFreeImage(test);
+        iioFreeImage(truth);
+        printf("%s: PSNR %.4lf dB, WS-PSNR %.4lf dB\n", argv[i], result.psnr, result.ws_psnr);
+        psnr += result.psnr;
+        ws_psnr += result.ws_psnr;
+    }
+    if (argc > 2)
+    {
+        printf("Average: PSNR %.4lf dB, WS-PSNR %.4lf dB\n", psnr / (argc / 2), ws_psnr / (argc / 2));
+    }
+    return EXIT_SUCCESS;
+}
+
+int runPack(int argc, char **argv)
+{
+    bool compress = (argc == 4 && strcmp(argv[3], "--compress") == 0);
+    if (argc != 3 && !compress)
+    {
+        printUsage("cdep_tool");
+        return EXIT_FAILURE;
+    }
+
+    SceneManifest scene;
+    if (!scnLoadManifest(argv[0], &scene))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Views are decoded one at a time and streamed to archive
+    OdsArchiveWriter writer;
+    if (!oaBeginArchive(argv[1], scene.images.size(), &writer))
+    {
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < scene.images.size(); i++)
+    {
+        uint8_t *color;
+        float *depth;
+        int width, height;
+        if (!scnReadImage(scene, i, std::max((int)std::thread::hardware_concurrency(), 1), &color, &depth, &width,
+                          &height))
+        {
+            oaFinishArchive(&writer);
+            return EXIT_FAILURE;
+        }
+        int success = oaAddView(&writer, scene.images[i].position, width, height, color, depth, compress);
+        iioFreeImage(color);
+        free(depth);
+        if (!success)
+        {
+            oaFinishArchive(&writer);
+            return EXIT_FAILURE;
+        }
+        printf("Packed %s (%dx%d)\n", scene.images[i].file_prefix.c_str(), width, height);
+    }
+    if (!oaFinishArchive(&writer))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Same scene, with images loaded from archive
+    FILE *fp = fopen(argv[2], "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    fprintf(fp, "{\n");
+    fprintf(fp, "    \"name\": ");
+    jsonWriteString(fp, scene.name);
+    fprintf(fp, ",\n");
+    fprintf(fp, "    \"format\": \"%s\",\n", scene.format.c_str());
+    fprintf(fp, "    \"num_views\": %d,\n", scene.num_views);
+    fprintf(fp, "    \"max_views\": %d,\n", scene.max_views);
+    if (scene.format == "dasp")
+    {
+        fprintf(fp, "    \"dasp_ipd\": %.6f,\n", scene.dasp_ipd);
+        fprintf(fp, "    \"dasp_focal_dist\": %.6f,\n", scene.dasp_focal_dist);
+    }
+    fprintf(fp, "    \"near\": %.6f,\n", scene.near);
+    fprintf(fp, "    \"far\": %.6f,\n", scene.far);
+    fprintf(fp, "    \"center\": [%.6f, %.6f, %.6f],\n", scene.center[0], scene.center[1], scene.center[2]);
+    fprintf(fp, "    \"archive\": ");
+    jsonWriteString(fp, argv[1]);
+    fprintf(fp, ",\n");
+    if (compress && scene.format == "cdep")
+    {
+        // Compressed C-DEP views are stored as tiles that can be uploaded as they come into view (used by direct
+        // viewport synthesis, ODS synthesis still loads whole views)
+        fprintf(fp, "    \"stream_tiles\": true,\n");
+    }
+    fprintf(fp, "    \"images\": [\n");
+    for (size_t i = 0; i < scene.images.size(); i++)
+    {
+        fprintf(fp, "        {\"file_prefix\": ");
+        jsonWriteString(fp, scene.images[i].file_prefix);
+        fprintf(fp, ", \"position\": [%.6f, %.6f, %.6f]}%s\n", scene.images[i].position[0],
+                scene.images[i].position[1], scene.images[i].position[2], (i + 1 < scene.images.size()) ? "," : "");
+    }
+    fprintf(fp, "    ]\n}\n");
+    fclose(fp);
+    return EXIT_SUCCESS;
+}
+
+int runTlz(int argc, char **argv)
+{
+    int tile_size = TLZ_DEFAULT_TILE_SIZE;
+    if (argc == 4 && strcmp(argv[2], "--tile") == 0)
+    {
+        tile_size = atoi(argv[3]);
+    }
+    else if (argc != 2)
+    {
+        printUsage("cdep_tool");
+        return EXIT_FAILURE;
+    }
+    if (tile_size < 1 || tile_size > 4096)
+    {
+        fprintf(stderr, "Error: tile size must be between 1 and 4096\n");
+        return EXIT_FAILURE;
+    }
+
+    int width, height;
+    int channels = 4;
+    uint8_t *pixels = iioReadImage(argv[0], &width, &height, &channels);
+    if (pixels == NULL)
+    {
+        fprintf(stderr, "Error: could not read %s\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    std::vector<uint8_t> encoded;
+    tcEncodeImage(pixels, width, height, TlzFormat::TLZ_FORMAT_RGBA8, tile_size, &encoded);
+
+    // Round trip check (also reports decode throughput of this machine)
+    int num_threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    size_t raw_size = (size_t)width * height * 4;
+    std::vector<uint8_t> decoded(raw_size);
+    auto start = std::chrono::steady_clock::now();
+    int success = tcDecodeImage(encoded.data(), encoded.size(), num_threads, decoded.data());
+    double decode_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    success = success && memcmp(decoded.data(), pixels, raw_size) == 0;
+    iioFreeImage(pixels);
+    if (!success)
+    {
+        fprintf(stderr, "Error: TLZ round trip of %s failed\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *fp = fopen(argv[1], "wb");
+    if (fp == NULL || fwrite(encoded.data(), 1, encoded.size(), fp) != encoded.size())
+    {
+        fprintf(stderr, "Error: could not write %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    fclose(fp);
+    printf("%s: %dx%d, %.1lf%% of raw size, decode %.2lf GB/s (%d threads)\n", argv[1], width, height,
+           100.0 * encoded.size() / raw_size, raw_size / std::max(decode_s, 1.0e-9) / 1.0e9, num_threads);
+    return EXIT_SUCCESS;
+}
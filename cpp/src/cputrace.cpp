@@ -0,0 +1,101 @@
+#include "cputrace.h"
+
+static std::chrono::steady_clock::time_point ct_epoch = std::chrono::steady_clock::now();
+static std::mutex ct_mutex;
+static std::vector<CpuTraceEvent> ct_events;
+static std::vector<std::pair<uint32_t,std::string>> ct_thread_names;
+static uint32_t ct_next_tid = 1;
+static uint32_t ct_dropped = 0;
+static thread_local uint32_t ct_tid = 0;
+
+CpuTraceZone::CpuTraceZone(const char *name)
+{
+    this->name = name;
+    start_us = ctNow();
+}
+
+CpuTraceZone::~CpuTraceZone()
+{
+    ctRecordZone(name, start_us, ctNow());
+}
+
+// Discards recorded zones and restarts clock (timestamps are relative to start of trace)
+void ctStartTrace()
+{
+    std::lock_guard<std::mutex> lock(ct_mutex);
+    ct_epoch = std::chrono::steady_clock::now();
+    ct_events.clear();
+    ct_dropped = 0;
+}
+
+void ctSetThreadName(const char *name)
+{
+    uint32_t tid = ctThreadId();
+    std::lock_guard<std::mutex> lock(ct_mutex);
+    ct_thread_names.push_back(std::make_pair(tid, std::string(name)));
+}
+
+void ctRecordZone(const char *name, int64_t start_us, int64_t end_us)
+{
+    CpuTraceEvent event;
+    event.name = name;
+    event.tid = ctThreadId();
+    event.start_us = start_us;
+    event.duration_us = end_us - start_us;
+
+    std::lock_guard<std::mutex> lock(ct_mutex);
+    if (ct_events.size() >= CPU_TRACE_MAX_EVENTS)
+    {
+        ct_dropped++;
+        return;
+    }
+    ct_events.push_back(event);
+}
+
+int64_t ctNow()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - ct_epoch).count();
+}
+
+// Writes zones as complete ("X") events in Chrome trace format (chrome://tracing, Perfetto)
+int ctWriteTrace(const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", filename);
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(ct_mutex);
+    size_t i;
+    fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    fprintf(fp, "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"cdep\"}}");
+    for (i = 0; i < ct_thread_names.size(); i++)
+    {
+        fprintf(fp, ",\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": \"%s\"}}",
+                ct_thread_names[i].first, ct_thread_names[i].second.c_str());
+    }
+    for (i = 0; i < ct_events.size(); i++)
+    {
+        fprintf(fp, ",\n  {\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %lld, \"dur\": %lld}",
+                ct_events[i].name.c_str(), ct_events[i].tid, (long long)ct_events[i].start_us,
+                (long long)ct_events[i].duration_us);
+    }
+    fprintf(fp, "\n], \"otherData\": {\"dropped_events\": %u}}\n", ct_dropped);
+    fclose(fp);
+    return 1;
+}
+
+
+// Private
+static uint32_t ctThreadId()
+{
+    // Small sequential ids (in order threads first record a zone) are easier to read than native ids
+    if (ct_tid == 0)
+    {
+        std::lock_guard<std::mutex> lock(ct_mutex);
+        ct_tid = ct_next_tid++;
+    }
+    return ct_tid;
+}
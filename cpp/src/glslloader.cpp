@@ -1,33 +1,190 @@
 #include "glslloader.h"
 
+#define PROGRAM_BINARY_MAGIC 0x42504C47 // "GLPB"
+
+// Program binary cache (empty directory disables cache)
+static std::string program_cache_directory;
+static std::map<GLuint,uint64_t> uncached_program_keys; // compiled from source, binary saved once linked
+static std::set<GLuint> cached_programs;                 // restored from binary, already linked
+
+// Source files, defines (identify specialized variants), shared headers, and compile and link time of each program
+typedef struct ProgramCompile {
+    std::vector<std::string> filenames;
+    std::vector<std::string> defines;
+    std::vector<std::string> headers;
+    std::string label;
+    std::chrono::steady_clock::time_point start;
+    double milliseconds;
+    bool binary;
+} ProgramCompile;
+static std::map<GLuint,ProgramCompile> program_compiles;
+
+// Shader files watched for hot reload (inotify on Linux, modification times elsewhere)
+#ifdef __linux__
+static int shader_watch_fd = -1;
+static std::map<int,std::string> shader_watch_directories; // watch descriptor -> directory
+#else
+static std::map<std::string,time_t> shader_file_times;
+#endif
+static std::chrono::steady_clock::time_point shader_last_check; // files are checked a few times per second
+
 // Public
-GLuint glsl::createShaderProgram(const char *vert_filename, const char *frag_filename)
+GLuint glsl::createShaderProgram(const char *vert_filename, const char *frag_filename,
+                                 const std::vector<std::string>& defines, const std::vector<std::string>& headers)
 {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     // Read vertex and fragment shaders from file
     char *vert_source, *frag_source;
     int32_t vert_length = readFile(vert_filename, &vert_source);
     int32_t frag_length = readFile(frag_filename, &frag_source);
-    if (vert_length < 0 || frag_length < 0)
+    std::string header;
+    if (vert_length < 0 || frag_length < 0 || readHeaders(headers, header) != 0)
     {
         return 0;
     }
+    injectPreamble(&vert_source, &vert_length, defines, header);
+    injectPreamble(&frag_source, &frag_length, defines, header);
+
+    // Use cached binary if this driver already linked the same sources
+    const char *filenames[2] = {vert_filename, frag_filename};
+    char *sources[2] = {vert_source, frag_source};
+    int32_t lengths[2] = {vert_length, frag_length};
+    uint64_t key = programKey(sources, lengths, 2);
+    GLuint program = loadProgramBinary(key);
+    if (program != 0)
+    {
+        beginCompileTime(program, filenames, 2, defines, headers, start, true);
+        free(vert_source);
+        free(frag_source);
+        return program;
+    }
 
     // Compile vetex shader
     GLuint vertex_shader = compileShader(vert_source, vert_length, GL_VERTEX_SHADER);
     // Compile fragment shader
     GLuint fragment_shader = compileShader(frag_source, frag_length, GL_FRAGMENT_SHADER);
+    free(vert_source);
+    free(frag_source);
 
     // Create GPU program from the compiled vertex and fragment shaders
     GLuint shaders[2] = {vertex_shader, fragment_shader};
-    GLuint program = attachShaders(shaders, 2);
+    program = attachShaders(shaders, 2);
+    uncached_program_keys[program] = key;
+    beginCompileTime(program, filenames, 2, defines, headers, start, false);
+
+    return program;
+}
+
+GLuint glsl::createShaderProgram(const char *vert_filename, const char *geom_filename, const char *frag_filename,
+                                 const std::vector<std::string>& defines, const std::vector<std::string>& headers)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // Read vertex, geometry, and fragment shaders from file
+    char *vert_source, *geom_source, *frag_source;
+    int32_t vert_length = readFile(vert_filename, &vert_source);
+    int32_t geom_length = readFile(geom_filename, &geom_source);
+    int32_t frag_length = readFile(frag_filename, &frag_source);
+    std::string header;
+    if (vert_length < 0 || geom_length < 0 || frag_length < 0 || readHeaders(headers, header) != 0)
+    {
+        return 0;
+    }
+    injectPreamble(&vert_source, &vert_length, defines, header);
+    injectPreamble(&geom_source, &geom_length, defines, header);
+    injectPreamble(&frag_source, &frag_length, defines, header);
+
+    // Use cached binary if this driver already linked the same sources
+    const char *filenames[3] = {vert_filename, geom_filename, frag_filename};
+    char *sources[3] = {vert_source, geom_source, frag_source};
+    int32_t lengths[3] = {vert_length, geom_length, frag_length};
+    uint64_t key = programKey(sources, lengths, 3);
+    GLuint program = loadProgramBinary(key);
+    if (program != 0)
+    {
+        beginCompileTime(program, filenames, 3, defines, headers, start, true);
+        free(vert_source);
+        free(geom_source);
+        free(frag_source);
+        return program;
+    }
+
+    // Compile vetex shader
+    GLuint vertex_shader = compileShader(vert_source, vert_length, GL_VERTEX_SHADER);
+    // Compile geometry shader
+    GLuint geometry_shader = compileShader(geom_source, geom_length, GL_GEOMETRY_SHADER);
+    // Compile fragment shader
+    GLuint fragment_shader = compileShader(frag_source, frag_length, GL_FRAGMENT_SHADER);
+    free(vert_source);
+    free(geom_source);
+    free(frag_source);
+
+    // Create GPU program from the compiled vertex, geometry, and fragment shaders
+    GLuint shaders[3] = {vertex_shader, geometry_shader, fragment_shader};
+    program = attachShaders(shaders, 3);
+    uncached_program_keys[program] = key;
+    beginCompileTime(program, filenames, 3, defines, headers, start, false);
+
+    return program;
+}
+
+GLuint glsl::createComputeProgram(const char *comp_filename, const std::vector<std::string>& defines,
+                                  const std::vector<std::string>& headers)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // Read compute shader from file
+    char *comp_source;
+    int32_t comp_length = readFile(comp_filename, &comp_source);
+    std::string header;
+    if (comp_length < 0 || readHeaders(headers, header) != 0)
+    {
+        return 0;
+    }
+    injectPreamble(&comp_source, &comp_length, defines, header);
+
+    // Use cached binary if this driver already linked the same source
+    const char *filenames[1] = {comp_filename};
+    char *sources[1] = {comp_source};
+    int32_t lengths[1] = {comp_length};
+    uint64_t key = programKey(sources, lengths, 1);
+    GLuint program = loadProgramBinary(key);
+    if (program != 0)
+    {
+        beginCompileTime(program, filenames, 1, defines, headers, start, true);
+        free(comp_source);
+        return program;
+    }
+
+    // Compile compute shader
+    GLuint compute_shader = compileShader(comp_source, comp_length, GL_COMPUTE_SHADER);
+    free(comp_source);
+
+    // Create GPU program from the compiled compute shader
+    GLuint shaders[1] = {compute_shader};
+    program = attachShaders(shaders, 1);
+    uncached_program_keys[program] = key;
+    beginCompileTime(program, filenames, 1, defines, headers, start, false);
 
     return program;
 }
 
 void glsl::linkShaderProgram(GLuint program)
 {
+    // Programs restored from binary cache are already linked
+    if (cached_programs.count(program) > 0)
+    {
+        return;
+    }
+
     // Link GPU program
     GLint status;
+    std::map<GLuint,uint64_t>::iterator uncached = uncached_program_keys.find(program);
+    if (uncached != uncached_program_keys.end())
+    {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(program);
 
     // Check to see if it linked successfully
@@ -42,6 +199,22 @@ void glsl::linkShaderProgram(GLuint program)
         fprintf(stderr, "%s\n", info);
         delete[] info;
     }
+    else if (uncached != uncached_program_keys.end())
+    {
+        saveProgramBinary(program, uncached->second);
+    }
+    if (uncached != uncached_program_keys.end())
+    {
+        uncached_program_keys.erase(uncached);
+    }
+
+    // Link status query waits for driver to finish compiling and linking
+    std::map<GLuint,ProgramCompile>::iterator compile = program_compiles.find(program);
+    if (compile != program_compiles.end())
+    {
+        compile->second.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                                                 compile->second.start).count();
+    }
 }
 
 void glsl::getShaderProgramUniforms(GLuint program, std::map<std::string,GLint>& uniforms)
@@ -62,6 +235,94 @@ void glsl::getShaderProgramUniforms(GLuint program, std::map<std::string,GLint>&
     }
 }
 
+// Linked programs are cached as driver specific binaries in `directory` (created if needed)
+void glsl::setProgramCacheDirectory(const char *directory)
+{
+    program_cache_directory = directory;
+    size_t i;
+    for (i = 1; i <= program_cache_directory.size(); i++)
+    {
+        if (i == program_cache_directory.size() || program_cache_directory[i] == '/' ||
+            program_cache_directory[i] == '\\')
+        {
+            std::string parent = program_cache_directory.substr(0, i);
+#ifdef _WIN32
+            _mkdir(parent.c_str());
+#else
+            mkdir(parent.c_str(), 0755);
+#endif
+        }
+    }
+}
+
+void glsl::printCompileTimes()
+{
+    double total = 0.0;
+    std::map<GLuint,ProgramCompile>::iterator it;
+    printf("Shader program compile times:\n");
+    for (it = program_compiles.begin(); it != program_compiles.end(); it++)
+    {
+        printf("  %-72s %8.2f ms%s\n", it->second.label.c_str(), it->second.milliseconds,
+               it->second.binary ? " (cached binary)" : "");
+        total += it->second.milliseconds;
+    }
+    printf("  %-72s %8.2f ms\n", "total", total);
+}
+
+// Recompiles and relinks programs that use a shader file changed since last call. Each rebuilt program replaces the
+// old one only if it links (old program keeps running while a shader has errors).
+// Caller swaps handles in `reloaded` (old, new) and re-queries their uniforms
+int glsl::reloadChangedPrograms(std::vector<std::pair<GLuint,GLuint>>& reloaded)
+{
+    std::set<std::string> changed = changedShaderFiles();
+    if (changed.empty())
+    {
+        return 0;
+    }
+
+    std::vector<GLuint> stale;
+    std::map<GLuint,ProgramCompile>::iterator it;
+    size_t i;
+    for (it = program_compiles.begin(); it != program_compiles.end(); it++)
+    {
+        std::vector<std::string> files = programFiles(it->first);
+        for (i = 0; i < files.size(); i++)
+        {
+            if (changed.count(files[i]) > 0)
+            {
+                stale.push_back(it->first);
+                break;
+            }
+        }
+    }
+
+    int num_reloaded = 0;
+    for (i = 0; i < stale.size(); i++)
+    {
+        ProgramCompile previous = program_compiles[stale[i]];
+        GLuint program = createProgram(previous.filenames, previous.defines, previous.headers);
+        if (program == 0)
+        {
+            continue;
+        }
+        linkShaderProgram(program);
+
+        GLint status;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        if (status == 0)
+        {
+            fprintf(stderr, "Error: could not reload %s (keeping previous program)\n", previous.label.c_str());
+            deleteProgram(program);
+            continue;
+        }
+        printf("Reloaded %s (%.2f ms)\n", previous.label.c_str(), program_compiles[program].milliseconds);
+        deleteProgram(stale[i]);
+        reloaded.push_back(std::make_pair(stale[i], program));
+        num_reloaded++;
+    }
+    return num_reloaded;
+}
+
 
 // Private
 GLint glsl::compileShader(char *source, int32_t length, GLenum type)
@@ -126,6 +387,9 @@ std::string glsl::shaderTypeToString(GLenum type)
         case GL_FRAGMENT_SHADER:
             shader_type = "fragment";
             break;
+        case GL_COMPUTE_SHADER:
+            shader_type = "compute";
+            break;
     }
     return shader_type;
 }
@@ -161,3 +425,338 @@ int32_t glsl::readFile(const char* filename, char** data_ptr)
 
     return fsize;
 }
+
+int glsl::readHeaders(const std::vector<std::string>& headers, std::string& text)
+{
+    size_t i;
+    for (i = 0; i < headers.size(); i++)
+    {
+        char *source;
+        int32_t length = readFile(headers[i].c_str(), &source);
+        if (length < 0)
+        {
+            return 1;
+        }
+        text.append(source, length);
+        if (length > 0 && source[length - 1] != '\n')
+        {
+            text += '\n';
+        }
+        free(source);
+    }
+    return 0;
+}
+
+// #version must stay first line, so defines go right after it (#line keeps compile error line numbers matching file)
+void glsl::injectPreamble(char **source, int32_t *length, const std::vector<std::string>& defines,
+                          const std::string& header)
+{
+    if (defines.empty() && header.empty())
+    {
+        return;
+    }
+    std::string text(*source, *length);
+    size_t insert = 0;
+    size_t version = text.find("#version");
+    if (version != std::string::npos)
+    {
+        insert = text.find('\n', version);
+        if (insert == std::string::npos)
+        {
+            text += '\n';
+            insert = text.size() - 1;
+        }
+        insert++;
+    }
+    std::string lines;
+    size_t i;
+    for (i = 0; i < defines.size(); i++)
+    {
+        lines += "#define " + defines[i] + "\n";
+    }
+    lines += header;
+    lines += "#line " + std::to_string(std::count(text.begin(), text.begin() + insert, '\n') + 1) + "\n";
+    text.insert(insert, lines);
+
+    free(*source);
+    *source = (char*)malloc(text.size());
+    memcpy(*source, text.data(), text.size());
+    *length = text.size();
+}
+
+void glsl::beginCompileTime(GLuint program, const char *filenames[], uint16_t num_files,
+                            const std::vector<std::string>& defines, const std::vector<std::string>& headers,
+                            std::chrono::steady_clock::time_point start, bool binary)
+{
+    ProgramCompile compile;
+    compile.filenames.assign(filenames, filenames + num_files);
+    compile.defines = defines;
+    compile.headers = headers;
+    size_t i;
+    for (i = 0; i < num_files; i++)
+    {
+        const char *name = strrchr(filenames[i], '/');
+        compile.label += std::string(i > 0 ? " + " : "") + (name != NULL ? name + 1 : filenames[i]);
+    }
+    for (i = 0; i < defines.size(); i++)
+    {
+        compile.label += std::string(i > 0 ? ", " : " [") + defines[i] + (i == defines.size() - 1 ? "]" : "");
+    }
+    compile.start = start;
+    compile.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    compile.binary = binary;
+    program_compiles[program] = compile;
+}
+
+// FNV-1a over sources and driver (binaries are only valid for the driver that created them)
+uint64_t glsl::programKey(char *sources[], int32_t lengths[], uint16_t num_sources)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    int i, j;
+    for (i = 0; i < num_sources; i++)
+    {
+        for (j = 0; j < lengths[i]; j++)
+        {
+            hash = (hash ^ (uint8_t)sources[i][j]) * 1099511628211ULL;
+        }
+        hash = (hash ^ 0xFF) * 1099511628211ULL; // source separator
+    }
+    GLenum driver_strings[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for (i = 0; i < 3; i++)
+    {
+        const GLubyte *driver = glGetString(driver_strings[i]);
+        for (j = 0; driver != NULL && driver[j] != '\0'; j++)
+        {
+            hash = (hash ^ driver[j]) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+GLuint glsl::loadProgramBinary(uint64_t key)
+{
+    GLint num_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    if (program_cache_directory.empty() || num_formats == 0)
+    {
+        return 0;
+    }
+
+    FILE *fp = fopen(programBinaryFilename(key).c_str(), "rb");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    uint32_t header[3]; // magic, binary format, binary length
+    std::vector<uint8_t> binary;
+    bool valid = fread(header, sizeof(header), 1, fp) == 1 && header[0] == PROGRAM_BINARY_MAGIC;
+    if (valid)
+    {
+        // Truncated or corrupt entry is a cache miss (length must match rest of file)
+        long data_start = ftell(fp);
+        fseek(fp, 0, SEEK_END);
+        valid = data_start >= 0 && ftell(fp) - data_start == (long)header[2];
+        fseek(fp, data_start, SEEK_SET);
+    }
+    if (valid)
+    {
+        binary.resize(header[2]);
+        valid = fread(binary.data(), 1, binary.size(), fp) == binary.size();
+    }
+    fclose(fp);
+    if (!valid)
+    {
+        return 0;
+    }
+
+    // Driver may still reject binary (e.g. after an update that kept its version string) - caller then compiles
+    GLint status;
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header[1], binary.data(), binary.size());
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status == 0)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+    cached_programs.insert(program);
+    return program;
+}
+
+void glsl::saveProgramBinary(GLuint program, uint64_t key)
+{
+    if (program_cache_directory.empty())
+    {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+    GLenum format;
+    std::vector<uint8_t> binary(length);
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    // Written under temporary name, so an interrupted write never leaves a truncated binary
+    std::string filename = programBinaryFilename(key);
+    std::string temp_filename = filename + ".tmp";
+    FILE *fp = fopen(temp_filename.c_str(), "wb");
+    if (fp == NULL)
+    {
+        return;
+    }
+    uint32_t header[3] = {PROGRAM_BINARY_MAGIC, format, (uint32_t)length};
+    bool success = fwrite(header, sizeof(header), 1, fp) == 1 && fwrite(binary.data(), 1, length, fp) == (size_t)length;
+    success = (fclose(fp) == 0) && success;
+    remove(filename.c_str());
+    if (!success || rename(temp_filename.c_str(), filename.c_str()) != 0)
+    {
+        remove(temp_filename.c_str());
+    }
+}
+
+std::string glsl::programBinaryFilename(uint64_t key)
+{
+    char name[32];
+    snprintf(name, 32, "/%016llx.bin", (unsigned long long)key);
+    return program_cache_directory + name;
+}
+
+GLuint glsl::createProgram(const std::vector<std::string>& filenames, const std::vector<std::string>& defines,
+                           const std::vector<std::string>& headers)
+{
+    GLuint program = 0;
+    switch (filenames.size())
+    {
+        case 1:
+            program = createComputeProgram(filenames[0].c_str(), defines, headers);
+            break;
+        case 2:
+            program = createShaderProgram(filenames[0].c_str(), filenames[1].c_str(), defines, headers);
+            break;
+        case 3:
+            program = createShaderProgram(filenames[0].c_str(), filenames[1].c_str(), filenames[2].c_str(), defines,
+                                          headers);
+            break;
+    }
+    return program;
+}
+
+// Shader files and shared headers a program was compiled from
+std::vector<std::string> glsl::programFiles(GLuint program)
+{
+    const ProgramCompile& compile = program_compiles[program];
+    std::vector<std::string> files(compile.filenames);
+    files.insert(files.end(), compile.headers.begin(), compile.headers.end());
+    return files;
+}
+
+void glsl::deleteProgram(GLuint program)
+{
+    GLuint shaders[3];
+    GLsizei num_shaders = 0;
+    glGetAttachedShaders(program, 3, &num_shaders, shaders);
+    int i;
+    for (i = 0; i < num_shaders; i++)
+    {
+        glDeleteShader(shaders[i]); // freed along with program
+    }
+    glDeleteProgram(program);
+    program_compiles.erase(program);
+    uncached_program_keys.erase(program);
+    cached_programs.erase(program);
+}
+
+// Shader files written (or replaced) since last call
+std::set<std::string> glsl::changedShaderFiles()
+{
+    std::set<std::string> changed;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - shader_last_check < std::chrono::milliseconds(SHADER_RELOAD_INTERVAL_MS))
+    {
+        return changed;
+    }
+    shader_last_check = now;
+    std::map<GLuint,ProgramCompile>::iterator it;
+    size_t i;
+#ifdef __linux__
+    if (shader_watch_fd < 0)
+    {
+        shader_watch_fd = inotify_init1(IN_NONBLOCK);
+        if (shader_watch_fd < 0)
+        {
+            fprintf(stderr, "Error: could not watch shader files\n");
+            return changed;
+        }
+    }
+
+    // Watch directories rather than files, since editors often save by replacing a file (which ends watch on it)
+    std::set<std::string> directories;
+    std::map<int,std::string>::iterator watch;
+    for (watch = shader_watch_directories.begin(); watch != shader_watch_directories.end(); watch++)
+    {
+        directories.insert(watch->second);
+    }
+    for (it = program_compiles.begin(); it != program_compiles.end(); it++)
+    {
+        std::vector<std::string> files = programFiles(it->first);
+        for (i = 0; i < files.size(); i++)
+        {
+            size_t slash = files[i].find_last_of('/');
+            std::string directory = (slash == std::string::npos) ? "." : files[i].substr(0, slash);
+            if (directories.insert(directory).second)
+            {
+                int wd = inotify_add_watch(shader_watch_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+                if (wd >= 0)
+                {
+                    shader_watch_directories[wd] = directory;
+                }
+            }
+        }
+    }
+
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t length;
+    while ((length = read(shader_watch_fd, buffer, sizeof(buffer))) > 0)
+    {
+        ssize_t offset = 0;
+        while (offset < length)
+        {
+            struct inotify_event *event = (struct inotify_event*)(buffer + offset);
+            if (event->len > 0 && shader_watch_directories.count(event->wd) > 0)
+            {
+                changed.insert(shader_watch_directories[event->wd] + "/" + event->name);
+            }
+            offset += sizeof(struct inotify_event) + event->len;
+        }
+    }
+#else
+    for (it = program_compiles.begin(); it != program_compiles.end(); it++)
+    {
+        std::vector<std::string> files = programFiles(it->first);
+        for (i = 0; i < files.size(); i++)
+        {
+            struct stat info;
+            const std::string& filename = files[i];
+            if (stat(filename.c_str(), &info) != 0)
+            {
+                continue;
+            }
+            std::map<std::string,time_t>::iterator time = shader_file_times.find(filename);
+            if (time == shader_file_times.end())
+            {
+                shader_file_times[filename] = info.st_mtime;
+            }
+            else if (time->second != info.st_mtime)
+            {
+                time->second = info.st_mtime;
+                changed.insert(filename);
+            }
+        }
+    }
+#endif
+    return changed;
+}
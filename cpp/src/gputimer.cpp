@@ -0,0 +1,216 @@
+#include "gputimer.h"
+
+// Creates ring of `ring_size` GL_TIME_ELAPSED queries. Timer starts disabled (zones are ignored)
+void gtCreateTimer(GpuTimer *timer, int ring_size)
+{
+    timer->enabled = false;
+    timer->frame = 0;
+    timer->queries.resize(ring_size);
+    timer->zones.resize(ring_size);
+    timer->frames.resize(ring_size);
+    timer->head = 0;
+    timer->count = 0;
+    timer->zone_open = false;
+    timer->dropped = 0;
+    glGenQueries(ring_size, timer->queries.data());
+}
+
+void gtDestroyTimer(GpuTimer *timer)
+{
+    glDeleteQueries(timer->queries.size(), timer->queries.data());
+    timer->queries.clear();
+    timer->zones.clear();
+    timer->frames.clear();
+    timer->count = 0;
+}
+
+// Starts timing GPU work of a zone (zones cannot be nested - GL allows one active time elapsed query)
+void gtBeginZone(GpuTimer *timer, const std::string& zone)
+{
+    if (!timer->enabled || timer->zone_open)
+    {
+        return;
+    }
+
+    // Ring is full of results GPU has not finished yet - drop zone rather than stall
+    int ring_size = timer->queries.size();
+    if (timer->count == ring_size)
+    {
+        gtCollect(timer, false);
+        if (timer->count == ring_size)
+        {
+            timer->dropped++;
+            return;
+        }
+    }
+
+    int slot = (timer->head + timer->count) % ring_size;
+    timer->zones[slot] = zone;
+    timer->frames[slot] = timer->frame;
+    timer->count++;
+    timer->zone_open = true;
+    glBeginQuery(GL_TIME_ELAPSED, timer->queries[slot]);
+}
+
+void gtEndZone(GpuTimer *timer)
+{
+    if (!timer->zone_open)
+    {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    timer->zone_open = false;
+}
+
+// Collects finished queries (non-blocking) and advances frame number
+void gtEndFrame(GpuTimer *timer)
+{
+    gtEndZone(timer);
+    gtCollect(timer, false);
+    timer->frame++;
+}
+
+// Waits for all outstanding queries (call before exporting results)
+void gtFinish(GpuTimer *timer)
+{
+    gtEndZone(timer);
+    gtCollect(timer, true);
+}
+
+int gtWriteCsv(GpuTimer *timer, const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", filename);
+        return 0;
+    }
+    fprintf(fp, "frame,zone,ms\n");
+    for (size_t i = 0; i < timer->samples.size(); i++)
+    {
+        fprintf(fp, "%u,%s,%.6lf\n", timer->samples[i].frame, timer->samples[i].zone.c_str(), timer->samples[i].ms);
+    }
+    fclose(fp);
+    return 1;
+}
+
+int gtWriteJson(GpuTimer *timer, const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", filename);
+        return 0;
+    }
+
+    // Samples are stored in submission order, so each frame's zones are contiguous
+    fprintf(fp, "{\n  \"frames\": [");
+    size_t i = 0;
+    bool first_frame = true;
+    while (i < timer->samples.size())
+    {
+        uint32_t frame = timer->samples[i].frame;
+        fprintf(fp, "%s\n    {\"frame\": %u, \"zones\": [", first_frame ? "" : ",", frame);
+        bool first_zone = true;
+        while (i < timer->samples.size() && timer->samples[i].frame == frame)
+        {
+            fprintf(fp, "%s{\"name\": \"%s\", \"ms\": %.6lf}", first_zone ? "" : ", ",
+                    timer->samples[i].zone.c_str(), timer->samples[i].ms);
+            first_zone = false;
+            i++;
+        }
+        fprintf(fp, "]}");
+        first_frame = false;
+    }
+    fprintf(fp, "\n  ],\n  \"summary\": [");
+
+    std::map<std::string,std::vector<double>> zone_ms;
+    for (i = 0; i < timer->samples.size(); i++)
+    {
+        zone_ms[timer->samples[i].zone].push_back(timer->samples[i].ms);
+    }
+    bool first_zone = true;
+    for (std::map<std::string,std::vector<double>>::iterator it = zone_ms.begin(); it != zone_ms.end(); it++)
+    {
+        double total = 0.0;
+        for (size_t j = 0; j < it->second.size(); j++)
+        {
+            total += it->second[j];
+        }
+        fprintf(fp, "%s\n    {\"name\": \"%s\", \"count\": %zu, \"mean_ms\": %.6lf, \"min_ms\": %.6lf, \"max_ms\": %.6lf}",
+                first_zone ? "" : ",", it->first.c_str(), it->second.size(), total / it->second.size(),
+                *std::min_element(it->second.begin(), it->second.end()),
+                *std::max_element(it->second.begin(), it->second.end()));
+        first_zone = false;
+    }
+    fprintf(fp, "\n  ],\n  \"dropped\": %u\n}\n", timer->dropped);
+    fclose(fp);
+    return 1;
+}
+
+// Prints mean time of each zone, sorted from most to least expensive
+void gtPrintSummary(GpuTimer *timer)
+{
+    std::map<std::string,double> zone_total;
+    std::map<std::string,uint32_t> zone_count;
+    std::map<uint32_t,bool> frames;
+    double total = 0.0;
+    for (size_t i = 0; i < timer->samples.size(); i++)
+    {
+        zone_total[timer->samples[i].zone] += timer->samples[i].ms;
+        zone_count[timer->samples[i].zone]++;
+        frames[timer->samples[i].frame] = true;
+        total += timer->samples[i].ms;
+    }
+    if (frames.empty())
+    {
+        return;
+    }
+
+    std::vector<std::pair<double,std::string>> zones;
+    for (std::map<std::string,double>::iterator it = zone_total.begin(); it != zone_total.end(); it++)
+    {
+        zones.push_back(std::make_pair(it->second, it->first));
+    }
+    std::sort(zones.rbegin(), zones.rend());
+
+    printf("GPU time per frame: %.3lf ms (%zu frames, %u zones dropped)\n", total / frames.size(), frames.size(),
+           timer->dropped);
+    for (size_t i = 0; i < zones.size(); i++)
+    {
+        printf("  %-24s %8.3lf ms avg  %5.1lf%%\n", zones[i].second.c_str(), zones[i].first / zone_count[zones[i].second],
+               100.0 * zones[i].first / total);
+    }
+}
+
+
+// Private
+static void gtCollect(GpuTimer *timer, bool wait)
+{
+    // Queries complete in order, so stop at first one that is not available
+    int ring_size = timer->queries.size();
+    while (timer->count > 0)
+    {
+        GLuint query = timer->queries[timer->head];
+        if (!wait)
+        {
+            GLuint available = 0;
+            glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+            {
+                break;
+            }
+        }
+        GLuint64 elapsed_ns;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed_ns);
+
+        GpuTimerSample sample;
+        sample.frame = timer->frames[timer->head];
+        sample.zone = timer->zones[timer->head];
+        sample.ms = elapsed_ns / 1.0e6;
+        timer->samples.push_back(sample);
+
+        timer->head = (timer->head + 1) % ring_size;
+        timer->count--;
+    }
+}
@@ -0,0 +1,98 @@
+#include "holefill.h"
+
+// Fills empty pixels (depth >= empty_depth) of stacked ODS eye images. Each empty pixel searches up to
+// `radius` pixels in 8 directions and takes the farthest filled pixel found, so disocclusion holes are
+// filled from the background side rather than smeared with foreground
+int hfFillHoles(uint8_t *color, float *depth, int width, int height, int num_eyes, float empty_depth, int radius,
+                int num_threads)
+{
+    int t;
+    int num_rows = num_eyes * height;
+    int num_pixels = width * num_rows;
+
+    // Search unmodified copy of images (rows split evenly among threads)
+    uint8_t *src_color = new uint8_t[4 * num_pixels];
+    float *src_depth = new float[num_pixels];
+    memcpy(src_color, color, 4 * num_pixels * sizeof(uint8_t));
+    memcpy(src_depth, depth, num_pixels * sizeof(float));
+
+    std::vector<std::thread> threads;
+    std::vector<int> filled(num_threads, 0);
+    int rows_per_thread = (num_rows + num_threads - 1) / num_threads;
+    for (t = 0; t < num_threads; t++)
+    {
+        int row_start = t * rows_per_thread;
+        int row_end = std::min(row_start + rows_per_thread, num_rows);
+        threads.push_back(std::thread([=, &filled]() {
+            CpuTraceZone zone("hfFillRows");
+            filled[t] = hfFillRows(src_color, src_depth, color, depth, width, height, row_start, row_end,
+                                   empty_depth, radius);
+        }));
+    }
+    int total_filled = 0;
+    for (t = 0; t < num_threads; t++)
+    {
+        threads[t].join();
+        total_filled += filled[t];
+    }
+
+    // Free memory
+    delete[] src_color;
+    delete[] src_depth;
+
+    return total_filled;
+}
+
+int hfFillRows(const uint8_t *src_color, const float *src_depth, uint8_t *dst_color, float *dst_depth,
+               int width, int height, int row_start, int row_end, float empty_depth, int radius)
+{
+    const int directions[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+    int x, y, d, r;
+    int filled = 0;
+    for (y = row_start; y < row_end; y++)
+    {
+        // Search is limited to the same eye's image
+        int eye_start = (y / height) * height;
+        int eye_end = eye_start + height;
+        for (x = 0; x < width; x++)
+        {
+            int idx = y * width + x;
+            if (src_depth[idx] < empty_depth)
+            {
+                continue;
+            }
+
+            // Farthest of the nearest filled pixels in each direction
+            int best = -1;
+            for (d = 0; d < 8; d++)
+            {
+                for (r = 1; r <= radius; r++)
+                {
+                    int ny = y + r * directions[d][1];
+                    if (ny < eye_start || ny >= eye_end)
+                    {
+                        break;
+                    }
+                    // Azimuth wraps around horizontally
+                    int nx = ((x + r * directions[d][0]) % width + width) % width;
+                    int nidx = ny * width + nx;
+                    if (src_depth[nidx] < empty_depth)
+                    {
+                        if (best < 0 || src_depth[nidx] > src_depth[best])
+                        {
+                            best = nidx;
+                        }
+                        break;
+                    }
+                }
+            }
+            if (best >= 0)
+            {
+                memcpy(dst_color + 4 * idx, src_color + 4 * best, 4 * sizeof(uint8_t));
+                dst_depth[idx] = src_depth[best];
+                filled++;
+            }
+        }
+    }
+    return filled;
+}
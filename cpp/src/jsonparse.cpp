@@ -0,0 +1,257 @@
+#include "jsonparse.h"
+#include "imageio.h"
+
+// Parses a complete JSON document (returns 1 on success, 0 on syntax error)
+int jsonParse(const char *text, JsonValue *value)
+{
+    const char *end = jsonParseValue(jsonSkipWhitespace(text), value);
+    if (end == NULL || *jsonSkipWhitespace(end) != '\0')
+    {
+        fprintf(stderr, "Error: invalid JSON\n");
+        return 0;
+    }
+    return 1;
+}
+
+int jsonParseFile(const char *filename, JsonValue *value)
+{
+    char *data;
+    int size = iioReadFile(filename, &data);
+    if (size < 0)
+    {
+        return 0;
+    }
+    std::string text(data, size);
+    free(data);
+
+    if (!jsonParse(text.c_str(), value))
+    {
+        fprintf(stderr, "Error: could not parse %s\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+const JsonValue* jsonGetMember(const JsonValue& object, const char *key)
+{
+    if (object.type != JsonType::JSON_OBJECT)
+    {
+        return NULL;
+    }
+    std::map<std::string,JsonValue>::const_iterator it = object.object.find(key);
+    return (it != object.object.end()) ? &(it->second) : NULL;
+}
+
+double jsonGetNumber(const JsonValue& object, const char *key, double default_value)
+{
+    const JsonValue *member = jsonGetMember(object, key);
+    return (member != NULL && member->type == JsonType::JSON_NUMBER) ? member->number : default_value;
+}
+
+bool jsonGetBool(const JsonValue& object, const char *key, bool default_value)
+{
+    const JsonValue *member = jsonGetMember(object, key);
+    return (member != NULL && member->type == JsonType::JSON_BOOL) ? member->boolean : default_value;
+}
+
+std::string jsonGetString(const JsonValue& object, const char *key, const std::string& default_value)
+{
+    const JsonValue *member = jsonGetMember(object, key);
+    return (member != NULL && member->type == JsonType::JSON_STRING) ? member->string : default_value;
+}
+
+// Reads array of 3 numbers (returns 0 and leaves `vec` unchanged if missing or malformed)
+int jsonGetVec3(const JsonValue& object, const char *key, float *vec)
+{
+    const JsonValue *member = jsonGetMember(object, key);
+    if (member == NULL || member->type != JsonType::JSON_ARRAY || member->array.size() != 3)
+    {
+        return 0;
+    }
+    int i;
+    for (i = 0; i < 3; i++)
+    {
+        if (member->array[i].type != JsonType::JSON_NUMBER)
+        {
+            return 0;
+        }
+    }
+    for (i = 0; i < 3; i++)
+    {
+        vec[i] = member->array[i].number;
+    }
+    return 1;
+}
+
+// Writes quoted string with quotes, backslashes, and control characters escaped
+void jsonWriteString(FILE *fp, const std::string& value)
+{
+    fputc('"', fp);
+    size_t i;
+    for (i = 0; i < value.size(); i++)
+    {
+        unsigned char c = value[i];
+        if (c == '"' || c == '\\')
+        {
+            fprintf(fp, "\\%c", c);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(fp, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+
+// Private
+static const char* jsonParseValue(const char *text, JsonValue *value)
+{
+    value->type = JsonType::JSON_NULL;
+    if (*text == '{')
+    {
+        value->type = JsonType::JSON_OBJECT;
+        text = jsonSkipWhitespace(text + 1);
+        if (*text == '}')
+        {
+            return text + 1;
+        }
+        while (true)
+        {
+            std::string key;
+            text = jsonParseString(text, &key);
+            if (text == NULL)
+            {
+                return NULL;
+            }
+            text = jsonSkipWhitespace(text);
+            if (*text != ':')
+            {
+                return NULL;
+            }
+            text = jsonParseValue(jsonSkipWhitespace(text + 1), &(value->object[key]));
+            if (text == NULL)
+            {
+                return NULL;
+            }
+            text = jsonSkipWhitespace(text);
+            if (*text == '}')
+            {
+                return text + 1;
+            }
+            if (*text != ',')
+            {
+                return NULL;
+            }
+            text = jsonSkipWhitespace(text + 1);
+        }
+    }
+    else if (*text == '[')
+    {
+        value->type = JsonType::JSON_ARRAY;
+        text = jsonSkipWhitespace(text + 1);
+        if (*text == ']')
+        {
+            return text + 1;
+        }
+        while (true)
+        {
+            value->array.push_back(JsonValue());
+            text = jsonParseValue(text, &(value->array.back()));
+            if (text == NULL)
+            {
+                return NULL;
+            }
+            text = jsonSkipWhitespace(text);
+            if (*text == ']')
+            {
+                return text + 1;
+            }
+            if (*text != ',')
+            {
+                return NULL;
+            }
+            text = jsonSkipWhitespace(text + 1);
+        }
+    }
+    else if (*text == '"')
+    {
+        value->type = JsonType::JSON_STRING;
+        return jsonParseString(text, &(value->string));
+    }
+    else if (strncmp(text, "true", 4) == 0)
+    {
+        value->type = JsonType::JSON_BOOL;
+        value->boolean = true;
+        return text + 4;
+    }
+    else if (strncmp(text, "false", 5) == 0)
+    {
+        value->type = JsonType::JSON_BOOL;
+        value->boolean = false;
+        return text + 5;
+    }
+    else if (strncmp(text, "null", 4) == 0)
+    {
+        return text + 4;
+    }
+
+    char *end;
+    value->type = JsonType::JSON_NUMBER;
+    value->number = strtod(text, &end);
+    return (end == text) ? NULL : end;
+}
+
+static const char* jsonParseString(const char *text, std::string *string)
+{
+    if (*text != '"')
+    {
+        return NULL;
+    }
+    text++;
+    while (*text != '"')
+    {
+        if (*text == '\0')
+        {
+            return NULL;
+        }
+        // Simple escapes only (manifests do not need unicode escapes)
+        if (*text == '\\')
+        {
+            text++;
+            switch (*text)
+            {
+                case 'n':
+                    string->push_back('\n');
+                    break;
+                case 't':
+                    string->push_back('\t');
+                    break;
+                case '\0':
+                    return NULL;
+                default:
+                    string->push_back(*text);
+                    break;
+            }
+        }
+        else
+        {
+            string->push_back(*text);
+        }
+        text++;
+    }
+    return text + 1;
+}
+
+static const char* jsonSkipWhitespace(const char *text)
+{
+    while (*text == ' ' || *text == '\t' || *text == '\n' || *text == '\r')
+    {
+        text++;
+    }
+    return text;
+}
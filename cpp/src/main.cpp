@@ -13,26 +13,116 @@
 #include <glm/gtx/norm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "cputrace.h"
 #include "glslloader.h"
+#include "gputimer.h"
+#include "holefill.h"
 #include "imageio.h"
+#include "odsarchive.h"
+#include "quality.h"
+#include "scene.h"
 #include "textrender.h"
+#include "viewcache.h"
+#ifdef CDEP_BENCH
+#include "bench.h"
+#endif
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-//#define FORMAT_DASP
-#define FORMAT_SOS
 #define WINDOW_TITLE "CDEP Demo"
+#define ODS_EMPTY_DEPTH 1000.0
+#define ODS_TILE_SIZE 64
+#define ODS_PULL_PUSH_LEVELS 6
+#define ODS_REGION_GRID_X 8
+#define ODS_REGION_GRID_Y 4
+#define GPU_TIMER_RING_SIZE 512
+#define DEP_SHADER_HEADER "./resrc/shaders/dep_common.glsl" // blocks and helpers shared by DEP programs
 
 
 enum OdsFormat {DASP, CDEP};
+enum SynthesisUpdate {UPDATE_NONE, UPDATE_INCREMENTAL, UPDATE_FULL};
+enum FoveationRegion {FOVEA, PERIPHERY, BEHIND};
+enum HoleFill {HOLE_FILL_NONE, HOLE_FILL_GPU, HOLE_FILL_CPU};
+
+// Uniforms set by render passes (locations resolved once per link and indexed by slot, -1 if program does not use it)
+enum Uniform {UNIFORM_APERTURE, UNIFORM_CAMERA_EYE, UNIFORM_CAMERA_FOCAL_DIST, UNIFORM_CAMERA_IPD,
+              UNIFORM_CAMERA_POSITION, UNIFORM_CLEAR_REGIONS, UNIFORM_DEPTH_TOLERANCE, UNIFORM_DEPTHS,
+              UNIFORM_DIMS, UNIFORM_DST_DIMS, UNIFORM_EDGE_THRESHOLD, UNIFORM_EYE, UNIFORM_FILLED_REGIONS,
+              UNIFORM_FOCAL_LENGTH, UNIFORM_FOVEATION_REGION, UNIFORM_HIZ_CULLING, UNIFORM_HIZ_DEPTH,
+              UNIFORM_HIZ_MAX_LEVEL, UNIFORM_HIZ_TOLERANCE, UNIFORM_IMAGE, UNIFORM_IMG_FOCAL_DIST,
+              UNIFORM_IMG_INDEX, UNIFORM_IMG_IPD, UNIFORM_MAX_DEPTH, UNIFORM_MODEL, UNIFORM_MODELVIEW,
+              UNIFORM_ORTHO_PROJECTION, UNIFORM_PIXEL_SCALE, UNIFORM_PLANE_IN_FOCUS, UNIFORM_POINT_SIZE_SCALE,
+              UNIFORM_PROJECTION, UNIFORM_RADIUS, UNIFORM_REGION_GRID, UNIFORM_SRC_DIMS, UNIFORM_TEXTURE_OFFSET,
+              UNIFORM_TEXTURE_SCALE, UNIFORM_UNIT_POINT_SIZE, UNIFORM_VIEW, UNIFORM_VIEWPORT_ORIGIN,
+              UNIFORM_VIEWPORT_SIZE, NUM_UNIFORMS};
+const char *uniform_names[NUM_UNIFORMS] = {"aperture", "camera_eye", "camera_focal_dist", "camera_ipd",
+                                           "camera_position", "clear_regions", "depth_tolerance", "depths", "dims",
+                                           "dst_dims", "edge_threshold", "eye", "filled_regions[0]", "focal_length",
+                                           "foveation_region", "hiz_culling", "hiz_depth", "hiz_max_level",
+                                           "hiz_tolerance", "image", "img_focal_dist", "img_index", "img_ipd",
+                                           "max_depth", "model", "modelview", "ortho_projection", "pixel_scale",
+                                           "plane_in_focus", "point_size_scale", "projection", "radius",
+                                           "region_grid", "src_dims", "texture_offset", "texture_scale",
+                                           "unit_point_size", "view", "viewport_origin", "viewport_size"};
 
 typedef struct GlslProgram {
     GLuint program;
     std::map<std::string,GLint> uniforms;
+    GLint locations[NUM_UNIFORMS];
 } GlslProgram;
 
+typedef struct OdsTile {
+    GLint first;
+    GLsizei count[3];     // number of points at full, 1/4, and 1/16 density (each a prefix of the tile)
+    glm::vec3 direction;  // direction of tile center
+    float radius;         // angular radius bounding all of tile's pixels
+} OdsTile;
+
+typedef struct OdsStreamTile {
+    int x;
+    int y;
+    int width;
+    int height;
+    glm::vec3 direction;  // direction of tile center
+    float radius;         // angular radius bounding all of tile's pixels
+} OdsStreamTile;
+
+typedef struct OdsViewParams {
+    GLfloat camera_position[3]; // synthesized camera position relative to view's camera
+    GLfloat img_index;          // order of view (depth hint)
+    GLint layer;                // layer of view in texture arrays
+    GLint padding[3];           // std430 layout (ViewParams struct in DEP_SHADER_HEADER)
+} OdsViewParams;
+
+typedef struct OdsFrameParams {
+    GLfloat ortho_projection[16];
+    GLfloat xr_view_dir[3];
+    GLfloat camera_ipd;
+    GLfloat camera_focal_dist;
+    GLfloat xr_fovy;
+    GLfloat xr_aspect;
+    GLfloat foveation_behind_angle; // members in std140 order (FrameParams uniform block in DEP_SHADER_HEADER)
+} OdsFrameParams;
+
+typedef struct DrawArraysIndirectCommand {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first;
+    GLuint base_instance;
+} DrawArraysIndirectCommand;
+
+#ifdef CDEP_BENCH
+typedef struct BenchOptions {
+    std::string scene;
+    std::string camera_path;
+    std::string report;
+    int warmup_iterations;
+    int iterations;
+} BenchOptions;
+#endif
+
 typedef struct AppData {
     // OpenGL window
     int window_width;
@@ -44,6 +134,7 @@ typedef struct AppData {
     GLuint cube_vertex_array;
     GLuint sphere_vertex_array;
     GLuint ods_vertex_array;
+    GLuint empty_vertex_array;
     GLuint num_va_points;
     GLushort num_cube_triangles;
     GLushort num_sphere_triangles;
@@ -51,6 +142,7 @@ typedef struct AppData {
     GLuint vertex_position_attrib;
     GLuint vertex_texcoord_attrib;
     GLuint vertex_normal_attrib;
+    GLuint vertex_draw_id_attrib;
     // DASP / DEP images
     int ods_width;
     int ods_height;
@@ -60,14 +152,99 @@ typedef struct AppData {
     glm::mat4 ods_projection;
     float dasp_ipd;
     float dasp_focal_dist;
+    float camera_ipd;
+    float camera_focal_dist;
     std::vector<glm::vec3> camera_positions;
     std::vector<GLuint> color_textures;
     std::vector<GLuint> depth_textures;
+    GLuint color_texture_array;
+    GLuint depth_texture_array;
+    std::vector<OdsTile> ods_tiles;
+    std::vector<std::vector<float>> tile_min_depths;
+    // Tiled streaming of archive views (tiles are uploaded once they may project into viewport)
+    bool stream_tiles;
+    OdsArchive stream_archive;
+    std::vector<OdsStreamTile> stream_tile_bounds;
+    std::vector<int> stream_tile_of_ods_tile;
+    std::vector<std::vector<bool>> stream_resident;
+    uint64_t stream_bytes;
+    // Decoded views cached on disk (empty directory disables cache)
+    std::string view_cache_dir;
+    bool view_cache_compress;
     // Render target
     GLuint render_texture_color;
     GLuint render_texture_depth;
     GLuint render_depth_buffer;
     GLuint render_framebuffer;
+    // Temporal reuse of previous synthesized image
+    bool synthesis_cache_valid;
+    glm::vec3 cached_position;
+    double cached_yaw;
+    double cached_pitch;
+    std::vector<int> cached_view_indices;
+    bool incremental_synthesis;
+    float incremental_max_distance;
+    float incremental_edge_threshold;
+    int incremental_max_age;
+    int incremental_num_views;
+    int history_age;
+    GLuint history_texture_color;
+    GLuint history_texture_depth;
+    // Foveated (view-dependent) synthesis
+    bool foveated_synthesis;
+    float foveation_behind_angle;
+    int foveation_periphery_interval;
+    int foveation_behind_interval;
+    int foveation_stale_regions;
+    uint32_t foveation_frame;
+    // Direct viewport synthesis (no ODS image)
+    bool viewport_synthesis;
+    // Single pass stereo synthesis (geometry shader emits both eyes)
+    bool single_pass_stereo;
+    // Multi-draw-indirect synthesis (all views submitted in one call)
+    bool multi_draw_indirect;
+    GLuint view_params_buffer;
+    GLuint draw_indirect_buffer;
+    GLsizeiptr draw_indirect_capacity;
+    // Per-frame synthesis constants (uniform buffer shared by DEP programs)
+    GLuint frame_params_buffer;
+    // Compute shader splatting (packed RGB-D atomicMin instead of rasterized points)
+    bool compute_splatting;
+    float splat_max_depth;
+    GLuint splat_buffer;
+    // Hole filling after synthesis (depth-aware, fills from background side)
+    HoleFill hole_fill;
+    int hole_fill_radius;
+    int hole_fill_threads;
+    GLuint holefill_texture_color;
+    GLuint holefill_texture_depth;
+    // Pull-push gap filling (1 pixel points, gaps reconstructed from mip pyramid)
+    bool pull_push_fill;
+    float pull_push_depth_tolerance;
+    GLuint pullpush_texture_color;
+    GLuint pullpush_texture_depth;
+    // Hierarchical-Z culling (max-depth pyramid of previous frame, reprojected to current position)
+    bool hiz_culling;
+    bool hiz_active;
+    bool hiz_previous_valid;
+    float hiz_tolerance;
+    int hiz_levels;
+    GLuint hiz_texture;
+    GLuint hiz_framebuffer;
+    // Occlusion budget (views after the nearest few skip regions they already filled)
+    bool occlusion_budget;
+    int occlusion_budget_views;
+    std::vector<GLuint> region_queries;
+    // GPU time of each synthesis stage (exported on exit)
+    GpuTimer gpu_timer;
+    // Recompile shader programs when their source files change
+    bool shader_hot_reload;
+    // Scene manifest and output of synthesized images
+    std::string scene_filename;
+    std::string scene_name;
+    int scene_max_views;  // overrides manifest's views used per synthesized image (0: use manifest)
+    glm::vec3 scene_center;
+    bool save_synthesized_views;
     // App view
     glm::mat4 modelview;
     glm::mat4 projection;
@@ -79,6 +256,7 @@ typedef struct AppData {
     double camera_yaw;
     double camera_pitch;
     double fov;
+    bool depth_of_field;
     float aperture;
     float focal_length;
     float plane_in_focus;
@@ -91,21 +269,87 @@ AppData app;
 void init();
 void render();
 void synthesizeOdsImage(glm::vec3& camera_position);
+void drawOdsImage(glm::vec3& camera_position, std::vector<int>& view_indices, SynthesisUpdate update);
+void drawIndirectDepViews(int num_views);
+void drawComputeSplatViews(int num_views);
+void updateViewParamsBuffer(glm::vec3& camera_position, std::vector<int>& view_indices, int num_views);
+void updateFrameParamsBuffer();
+void uploadDrawCommands(std::vector<DrawArraysIndirectCommand>& commands);
+void fillOdsHoles();
+void pullPushOdsImage();
+SynthesisUpdate determineSynthesisUpdate(glm::vec3& camera_position, std::vector<int>& view_indices);
+void warpPreviousOdsImage(glm::vec3& camera_position, GLuint color_texture, GLuint depth_texture);
+void buildHiZPyramid(glm::vec3& camera_position);
+void setCullingUniforms(GlslProgram& program);
+void loadDepVariants();
+void resolveUniformLocations(GlslProgram& program);
+void reloadChangedShaders();
+std::string depProgramName(float eye, bool unit_point_size, bool hiz_culling);
+void setDepFrameUniforms(GlslProgram& program);
+void queryFilledRegions(int first_eye, int num_eyes, GLuint *filled_regions);
+int scheduleFoveatedRegions(std::vector<int>& view_indices, SynthesisUpdate update);
+void drawFoveatedOdsImage(glm::vec3& camera_position, std::vector<int>& view_indices, int regions);
+void gatherFoveatedTiles(int view_index, glm::vec3& relative_cam_pos, glm::vec3& view_dir, float diagonal_fov,
+                         int region, std::vector<GLint>& firsts, std::vector<GLsizei>& counts);
+void drawViewportSynthesis(glm::vec3& camera_position);
+void getXrViewCone(glm::vec3& view_dir, float& diagonal_fov);
+void computeTileBounds(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, glm::vec3& direction, float& radius);
+double tileViewMargin(float radius, double min_depth, double baseline);
 void onResize(GLFWwindow* window, int width, int height);
 void onMouseButton(GLFWwindow* window, int button, int action, int mods);
 void onMouseMove(GLFWwindow* window, double x_pos, double y_pos);
 void onKeyboardInput(GLFWwindow* window, int key, int scancode, int action, int mods);
-void initializeOdsTextures(const char *file_prefix, float *camera_position);
+int initializeOdsTextures(const SceneManifest& scene, int image);
+int initializeOdsArchive(const char *filename, int num_images, bool stream_tiles);
+int initializeOdsStreaming(OdsArchive& archive);
+void createOdsViewTextures(const uint8_t *color, const float *depth, int width, int height,
+                           const float *camera_position, std::vector<float>& tile_min_depth);
+void computeTileMinDepths(const float *depth, int width, int height, std::vector<float>& tile_min_depth);
+void streamOdsTiles(int view_index, glm::vec3& relative_cam_pos, glm::vec3& view_dir, float cone_angle);
+int initializeSceneManifest(const char *filename, double *near, double *far);
+int measureOdsQuality(const char *truth_filename, QualityResult *result);
 void initializeOdsRenderTargets();
+void createOdsTextureArrays();
+GLuint createTextureLayerView(GLuint texture_array, GLenum internal_format, int layer);
+void initializeIndirectDrawBuffers();
 uint32_t mortonZIndex(uint16_t x, uint16_t y);
 void blockShuffle(GLfloat* vertices, GLfloat* texcoords, uint32_t size, uint32_t block_size);
 void createOdsPointData();
 void createCube();
 void createSphere(int stacks, int slices);
 void determineViews(glm::vec3& camera_position, int num_views, std::vector<int>& view_indices);
+#ifdef CDEP_BENCH
+int runBenchmark(BenchOptions& options);
+#endif
 
 int main(int argc, char **argv)
 {
+#ifdef CDEP_BENCH
+    // Benchmark: cdep_bench <scene.json> <camera_path.json> [warmup_iterations] [iterations] [report.json]
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s <scene.json> <camera_path.json> [warmup_iterations] [iterations] [report.json]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    BenchOptions bench_options;
+    bench_options.scene = argv[1];
+    bench_options.camera_path = argv[2];
+    bench_options.warmup_iterations = (argc > 3) ? atoi(argv[3]) : 2;
+    bench_options.iterations = (argc > 4) ? atoi(argv[4]) : 10;
+    bench_options.report = (argc > 5) ? argv[5] : "bench_report.json";
+    app.scene_filename = bench_options.scene;
+    app.scene_max_views = 0;
+#else
+    // Scene manifest and optional number of views used per synthesized image: cdep_example [scene.json] [max_views]
+    app.scene_filename = (argc > 1) ? argv[1] : "./resrc/scenes/office_sos.json";
+    app.scene_max_views = (argc > 2) ? atoi(argv[2]) : 0;
+#endif
+
+    // Record CPU zones of all threads (written to cdep_trace.json on exit)
+    ctStartTrace();
+    ctSetThreadName("main");
+
     // Initialize GLFW
     if (!glfwInit())
     {
@@ -152,6 +396,15 @@ int main(int argc, char **argv)
     // Initialize app
     init();
 
+#ifdef CDEP_BENCH
+    // Replay camera path instead of interactive loop
+    int bench_status = runBenchmark(bench_options);
+    gtDestroyTimer(&app.gpu_timer);
+    glfwDestroyWindow(app.window);
+    glfwTerminate();
+    return bench_status;
+#endif
+
     // Main render loop
     uint32_t frame_count = 0;
     double fps_start = glfwGetTime();
@@ -163,6 +416,8 @@ int main(int argc, char **argv)
     double avg_frame_time_list[10];
     while (!glfwWindowShouldClose(app.window))
     {
+        CpuTraceZone frame_zone("frame");
+
         // Print frame rate
         double now = glfwGetTime();
         if ((now - fps_start) >= 2.0)
@@ -199,8 +454,13 @@ int main(int argc, char **argv)
         //app.synthesized_position = glm::vec3(0.0, 1.70, 0.0);
         //app.synthesized_position = glm::vec3(0.0, 1.70, 0.725) + glm::vec3(0.3175 * cos(0.5 * t), 0.15 * cos(t), 0.1425 * sin(t));
         
-        glm::vec3 center = glm::vec3(0.0, 1.70, 0.725); // office
-        //glm::vec3 center = glm::vec3(0.0, 1.70, 0.0); // spheres
+        // Pick up edited shaders before synthesizing
+        if (app.shader_hot_reload)
+        {
+            reloadChangedShaders();
+        }
+
+        glm::vec3 center = app.scene_center;
         glm::vec3 position[8] = {
             glm::vec3( 0.317500,  0.150000,  0.000000),
             glm::vec3( 0.224506,  0.129904,  0.142500),
@@ -230,16 +490,37 @@ int main(int argc, char **argv)
         //                                                     app.synthesized_position[2]);
 
         app.fc++;
-        if (app.fc >= num_frames) exit(EXIT_SUCCESS);
+        if (app.fc >= num_frames) break;
 
         // Render next frame
         render();
+        gtEndFrame(&app.gpu_timer);
         glfwPollEvents();
 
         // Increment frame counter
         frame_count++;
     }
 
+    // Export GPU stage timings
+    if (app.gpu_timer.enabled)
+    {
+        gtFinish(&app.gpu_timer);
+        gtWriteCsv(&app.gpu_timer, "gpu_timings.csv");
+        gtWriteJson(&app.gpu_timer, "gpu_timings.json");
+        gtPrintSummary(&app.gpu_timer);
+    }
+    gtDestroyTimer(&app.gpu_timer);
+
+    // Export CPU trace
+    ctWriteTrace("cdep_trace.json");
+
+    if (app.stream_tiles)
+    {
+        printf("Streamed %.1lf of %.1lf MB of view tiles\n", app.stream_bytes / (1024.0 * 1024.0),
+               app.stream_archive.size / (1024.0 * 1024.0));
+        oaCloseArchive(&app.stream_archive);
+    }
+
     // Clean up
     glfwDestroyWindow(app.window);
     glfwTerminate();
@@ -249,139 +530,163 @@ int main(int argc, char **argv)
 
 void init()
 {
+    CpuTraceZone zone("init");
+
     // Set OpenGL settings
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_PROGRAM_POINT_SIZE);
 
-    // Initialize vertex attributes
+    // Initialize vertex attributes (same locations as layout qualifiers of vertex shader inputs)
     app.vertex_position_attrib = 0;
     app.vertex_texcoord_attrib = 1;
     app.vertex_normal_attrib = 2;
+    app.vertex_draw_id_attrib = 3;
+
+    // Reuse linked shader programs of previous launches (keyed by shader sources and driver)
+    glsl::setProgramCacheDirectory("./cache/shaders");
+
+    // Only load shaders at startup (set true to rebuild programs when their shader files change while running)
+    app.shader_hot_reload = false;
 
     // Load DASP shader
     GlslProgram dasp;
     dasp.program = glsl::createShaderProgram("./resrc/shaders/dasp.vert", "./resrc/shaders/dasp.frag");
-    glBindAttribLocation(dasp.program, app.vertex_position_attrib, "vertex_position");
-    glBindAttribLocation(dasp.program, app.vertex_texcoord_attrib, "vertex_texcoord");
     glsl::linkShaderProgram(dasp.program);
     glsl::getShaderProgramUniforms(dasp.program, dasp.uniforms);
     app.glsl_program["DASP"] = dasp;
 
-    // Load DEP shader
-    GlslProgram dep;
-    dep.program = glsl::createShaderProgram("./resrc/shaders/dep.vert", "./resrc/shaders/dep.frag");
-    glBindAttribLocation(dep.program, app.vertex_position_attrib, "vertex_position");
-    glBindAttribLocation(dep.program, app.vertex_texcoord_attrib, "vertex_texcoord");
-    glsl::linkShaderProgram(dep.program);
-    glsl::getShaderProgramUniforms(dep.program, dep.uniforms);
-    app.glsl_program["DEP"] = dep;
-
-    // Load depth ODS (no lighting / per-fragment depth) shader
+    // Load DEP shader (specialized variant for each eye, point size mode, and hierarchical-Z culling)
+    loadDepVariants();
+
+    // Load DEP single pass stereo shader
+    std::vector<std::string> dep_headers(1, DEP_SHADER_HEADER);
+    GlslProgram dep_stereo;
+    dep_stereo.program = glsl::createShaderProgram("./resrc/shaders/dep_stereo.vert", "./resrc/shaders/dep_stereo.geom",
+                                                   "./resrc/shaders/dep.frag", std::vector<std::string>(), dep_headers);
+    glsl::linkShaderProgram(dep_stereo.program);
+    glsl::getShaderProgramUniforms(dep_stereo.program, dep_stereo.uniforms);
+    app.glsl_program["DEP_stereo"] = dep_stereo;
+
+    // Load DEP multi-draw-indirect shader
+    GlslProgram dep_indirect;
+    dep_indirect.program = glsl::createShaderProgram("./resrc/shaders/dep_indirect.vert", "./resrc/shaders/dep_stereo.geom",
+                                                     "./resrc/shaders/dep_indirect.frag",
+                                                     std::vector<std::string>(1, "VIEW_LAYERS"), dep_headers);
+    glsl::linkShaderProgram(dep_indirect.program);
+    glsl::getShaderProgramUniforms(dep_indirect.program, dep_indirect.uniforms);
+    app.glsl_program["DEP_indirect"] = dep_indirect;
+
+    // Load DEP compute splatting shaders (clear, splat, and resolve to texture)
+    GlslProgram splat_clear;
+    splat_clear.program = glsl::createComputeProgram("./resrc/shaders/ods_splat_clear.comp");
+    glsl::linkShaderProgram(splat_clear.program);
+    glsl::getShaderProgramUniforms(splat_clear.program, splat_clear.uniforms);
+    app.glsl_program["ODS_splat_clear"] = splat_clear;
+
+    GlslProgram dep_splat;
+    dep_splat.program = glsl::createComputeProgram("./resrc/shaders/dep_splat.comp", std::vector<std::string>(), dep_headers);
+    glsl::linkShaderProgram(dep_splat.program);
+    glsl::getShaderProgramUniforms(dep_splat.program, dep_splat.uniforms);
+    app.glsl_program["DEP_splat"] = dep_splat;
+
+    GlslProgram splat_resolve;
+    splat_resolve.program = glsl::createComputeProgram("./resrc/shaders/ods_splat_resolve.comp");
+    glsl::linkShaderProgram(splat_resolve.program);
+    glsl::getShaderProgramUniforms(splat_resolve.program, splat_resolve.uniforms);
+    app.glsl_program["ODS_splat_resolve"] = splat_resolve;
+
+    // Load hole filling shader
+    GlslProgram hole_fill;
+    hole_fill.program = glsl::createComputeProgram("./resrc/shaders/ods_hole_fill.comp");
+    glsl::linkShaderProgram(hole_fill.program);
+    glsl::getShaderProgramUniforms(hole_fill.program, hole_fill.uniforms);
+    app.glsl_program["ODS_hole_fill"] = hole_fill;
+
+    // Load pull-push shaders
+    GlslProgram pull;
+    pull.program = glsl::createComputeProgram("./resrc/shaders/ods_pull.comp");
+    glsl::linkShaderProgram(pull.program);
+    glsl::getShaderProgramUniforms(pull.program, pull.uniforms);
+    app.glsl_program["ODS_pull"] = pull;
+
+    GlslProgram push;
+    push.program = glsl::createComputeProgram("./resrc/shaders/ods_push.comp");
+    glsl::linkShaderProgram(push.program);
+    glsl::getShaderProgramUniforms(push.program, push.uniforms);
+    app.glsl_program["ODS_push"] = push;
+
+    // Load hierarchical-Z reduction shader
+    GlslProgram hiz_reduce;
+    hiz_reduce.program = glsl::createComputeProgram("./resrc/shaders/ods_hiz_reduce.comp");
+    glsl::linkShaderProgram(hiz_reduce.program);
+    glsl::getShaderProgramUniforms(hiz_reduce.program, hiz_reduce.uniforms);
+    app.glsl_program["ODS_hiz_reduce"] = hiz_reduce;
+
+    // Load DEP direct viewport shader
+    GlslProgram dep_viewport;
+    dep_viewport.program = glsl::createShaderProgram("./resrc/shaders/dep_viewport.vert", "./resrc/shaders/dep.frag");
+    glsl::linkShaderProgram(dep_viewport.program);
+    glsl::getShaderProgramUniforms(dep_viewport.program, dep_viewport.uniforms);
+    app.glsl_program["DEP_viewport"] = dep_viewport;
+
+    // Load depth ODS (no lighting / per-fragment depth) shader, with and without depth of field
     GlslProgram depth_ods;
     depth_ods.program = glsl::createShaderProgram("./resrc/shaders/depth_ods.vert", "./resrc/shaders/depth_ods.frag");
-    glBindAttribLocation(depth_ods.program, app.vertex_position_attrib, "vertex_position");
-    glBindAttribLocation(depth_ods.program, app.vertex_texcoord_attrib, "vertex_texcoord");
     glsl::linkShaderProgram(depth_ods.program);
     glsl::getShaderProgramUniforms(depth_ods.program, depth_ods.uniforms);
     app.glsl_program["depth_ods"] = depth_ods;
 
+    GlslProgram depth_ods_dof;
+    depth_ods_dof.program = glsl::createShaderProgram("./resrc/shaders/depth_ods.vert", "./resrc/shaders/depth_ods.frag",
+                                                      std::vector<std::string>(1, "DEPTH_OF_FIELD"));
+    glsl::linkShaderProgram(depth_ods_dof.program);
+    glsl::getShaderProgramUniforms(depth_ods_dof.program, depth_ods_dof.uniforms);
+    app.glsl_program["depth_ods_dof"] = depth_ods_dof;
+
     // Load Phong lighting shader
     GlslProgram phong;
     phong.program = glsl::createShaderProgram("./resrc/shaders/phong.vert", "./resrc/shaders/phong.frag");
-    glBindAttribLocation(phong.program, app.vertex_position_attrib, "vertex_position");
-    glBindAttribLocation(phong.program, app.vertex_texcoord_attrib, "vertex_texcoord");
-    glBindAttribLocation(phong.program, app.vertex_normal_attrib, "vertex_normal");
     glsl::linkShaderProgram(phong.program);
     glsl::getShaderProgramUniforms(phong.program, phong.uniforms);
     app.glsl_program["phong"] = phong;
 
-    // Initialize ODS textures
-#if defined(FORMAT_DASP)
-    // DASP
-    app.ods_format = OdsFormat::DASP;
-    app.ods_num_views = 1;
-    app.ods_max_views = 1;
-    app.dasp_ipd = 0.7;
-    app.dasp_focal_dist = 1.95;
-    double near = 0.1;
-    double far = 50.0;
-    float cam_position[3] = {0.0, 1.7, 0.725};
-    initializeOdsTextures("./resrc/images/ods_dasp_4k_left", cam_position);
-    initializeOdsTextures("./resrc/images/ods_dasp_4k_right", cam_position);
-    // float cam_position[3] = {0.0, 1.7, 0.0};
-    // initializeOdsTextures("./resrc/images/spheres_ods_dasp_4k_left", cam_position);
-    // initializeOdsTextures("./resrc/images/spheres_ods_dasp_4k_right", cam_position);
-#elif defined(FORMAT_SOS)
-    // SOS
-    app.ods_format = OdsFormat::DASP;
-    app.ods_num_views = 2;
-    app.ods_max_views = 2;
-    app.dasp_ipd = 0.7;
-    app.dasp_focal_dist = 1.95;
-    double near = 0.1;
-    double far = 50.0;
-    float cam_position1[3] = {0.0, 1.55, 0.725};
-    float cam_position2[3] = {0.0, 1.85, 0.725};
-    initializeOdsTextures("./resrc/images/ods_sos1_4k_left", cam_position1);
-    initializeOdsTextures("./resrc/images/ods_sos1_4k_right", cam_position1);
-    initializeOdsTextures("./resrc/images/ods_sos2_4k_left", cam_position2);
-    initializeOdsTextures("./resrc/images/ods_sos2_4k_right", cam_position2);
-    // float cam_position1[3] = {0.0, 1.55, 0.0};
-    // float cam_position2[3] = {0.0, 1.85, 0.0};
-    // initializeOdsTextures("./resrc/images/spheres_ods_sos1_4k_left", cam_position1);
-    // initializeOdsTextures("./resrc/images/spheres_ods_sos1_4k_right", cam_position1);
-    // initializeOdsTextures("./resrc/images/spheres_ods_sos2_4k_left", cam_position2);
-    // initializeOdsTextures("./resrc/images/spheres_ods_sos2_4k_right", cam_position2);
-#else
-    // C-DEP
-    app.ods_format = OdsFormat::CDEP;
-    app.ods_num_views = 8;
-    app.ods_max_views = 8;
-    double near = 0.01; //0.1;
-    double far = 30.0; //50.0;
-
-    // float cam_position1[3] = {-2.3638009325989064, 1.6626330584754445, -13.1379285788494};
-    // float cam_position2[3] = {-2.3431789554542077, 1.6553537411051626, -13.8433799047119};
-    // //float cam_position2[3] = {-2.3431789554542077, 1.6553537411051626, -13.9133799047119};
-    // float cam_position3[3] = {-2.3902531743086084, 1.6660253403880460, -13.4645635290832};
-    // initializeOdsTextures("./resrc/images/hallway_2k_camera_1", cam_position1);
-    // initializeOdsTextures("./resrc/images/hallway_2k_camera_2", cam_position2);
-    // initializeOdsTextures("./resrc/images/hallway_2k_camera_3", cam_position3);
-
-    float cam_position1[3] = {-0.35, 1.85, 0.55};
-    float cam_position2[3] = { 0.35, 1.55, 0.90};
-    float cam_position3[3] = {-0.10, 1.75, 0.85};
-    float cam_position4[3] = { 0.25, 1.70, 0.60};
-    float cam_position5[3] = {-0.30, 1.67, 0.75};
-    float cam_position6[3] = {-0.20, 1.60, 0.70};
-    float cam_position7[3] = { 0.15, 1.78, 0.57};
-    float cam_position8[3] = { 0.05, 1.82, 0.87};
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_1", cam_position1);
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_2", cam_position2);
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_3", cam_position3);
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_4", cam_position4);
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_5", cam_position5);
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_6", cam_position6);
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_7", cam_position7);
-    initializeOdsTextures("./resrc/images/ods_cdep_4k_camera_8", cam_position8);
-
-    // float cam_position1[3] = {-0.35, 1.85, -0.175};
-    // float cam_position2[3] = { 0.35, 1.55,  0.175};
-    // float cam_position3[3] = {-0.10, 1.75,  0.125};
-    // float cam_position4[3] = { 0.25, 1.70, -0.125};
-    // float cam_position5[3] = {-0.30, 1.67,  0.025};
-    // float cam_position6[3] = {-0.20, 1.60, -0.025};
-    // float cam_position7[3] = { 0.15, 1.78, -0.155};
-    // float cam_position8[3] = { 0.05, 1.82,  0.145};
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_1", cam_position1);
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_2", cam_position2);
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_3", cam_position3);
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_4", cam_position4);
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_5", cam_position5);
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_6", cam_position6);
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_7", cam_position7);
-    // initializeOdsTextures("./resrc/images/spheres_ods_cdep_4k_camera_8", cam_position8);
-#endif
+    // Load ODS region clear shader
+    GlslProgram ods_clear;
+    ods_clear.program = glsl::createShaderProgram("./resrc/shaders/ods_clear.vert", "./resrc/shaders/ods_clear.frag",
+                                                  std::vector<std::string>(), dep_headers);
+    glsl::linkShaderProgram(ods_clear.program);
+    glsl::getShaderProgramUniforms(ods_clear.program, ods_clear.uniforms);
+    app.glsl_program["ods_clear"] = ods_clear;
+
+    // Load ODS hole query shader (full screen pass that only passes where nothing was drawn)
+    GlslProgram ods_hole_query;
+    ods_hole_query.program = glsl::createShaderProgram("./resrc/shaders/ods_clear.vert", "./resrc/shaders/ods_hole_query.frag");
+    glsl::linkShaderProgram(ods_hole_query.program);
+    glsl::getShaderProgramUniforms(ods_hole_query.program, ods_hole_query.uniforms);
+    app.glsl_program["ods_hole_query"] = ods_hole_query;
+    glsl::printCompileTimes();
+
+    // Resolve uniform slots of every program (draw loops index locations instead of looking uniforms up by name)
+    std::map<std::string,GlslProgram>::iterator program;
+    for (program = app.glsl_program.begin(); program != app.glsl_program.end(); program++)
+    {
+        resolveUniformLocations(program->second);
+    }
+
+    // Synthesize ODS image, then sample it for current view (set true to reproject directly into view)
+    app.viewport_synthesis = false;
+
+    // Initialize ODS textures (scene manifest lists images, camera positions, and projection parameters)
+    app.stream_tiles = false;
+    app.stream_bytes = 0;
+    app.view_cache_dir = "./cache/views";
+    app.view_cache_compress = false;
+    double near, far;
+    if (!initializeSceneManifest(app.scene_filename.c_str(), &near, &far))
+    {
+        fprintf(stderr, "Error: could not load scene %s\n", app.scene_filename.c_str());
+        exit(EXIT_FAILURE);
+    }
 
     // Initialize ODS render targets
     initializeOdsRenderTargets();
@@ -389,14 +694,22 @@ void init()
     // Create ODS pointcloud model
     createOdsPointData();
 
+    // Move ODS images into texture arrays and create per-view buffers for multi-draw-indirect
+    createOdsTextureArrays();
+    initializeIndirectDrawBuffers();
+
     // Create quad for rendering
     createCube();
 
     // Create sphere for rendering
     createSphere(18, 36);
 
+    // Create vertex array without attributes (for full screen passes)
+    glGenVertexArrays(1, &(app.empty_vertex_array));
+
     // Set ODS projection matrix
     app.ods_projection = glm::ortho(2.0 * M_PI, 0.0, M_PI, 0.0, near, far);
+    app.splat_max_depth = far;
 
     // Set App view modelview and projection matrices
     app.fov = 45.0;
@@ -408,12 +721,69 @@ void init()
     app.view_pan = false;
     app.camera_yaw = 0.0;
     app.camera_pitch = 0.0;
+    // Sharp display (toggle with B to blur by distance from plane in focus)
+    app.depth_of_field = false;
     app.aperture = 0.027;
     app.focal_length = 0.05;
     app.plane_in_focus = 2.15;
 
+    app.camera_ipd = 0.065;
+    app.camera_focal_dist = 1.95;
     app.synthesized_position = glm::vec3(0.15, 1.77, 0.77);
 
+    // Reuse previous synthesized image when camera moves less than 5 cm (full re-synthesis every 8 frames)
+    app.synthesis_cache_valid = false;
+    app.incremental_synthesis = true;
+    app.incremental_max_distance = 0.05;
+    app.incremental_edge_threshold = 0.1;
+    app.incremental_max_age = 8;
+    app.incremental_num_views = 2;
+    app.history_age = 0;
+
+    // Foveated synthesis: XR viewport every frame, periphery every 4th frame, behind viewer every 16th frame
+    app.foveated_synthesis = false;
+    app.foveation_behind_angle = 0.6667 * M_PI;
+    app.foveation_periphery_interval = 4;
+    app.foveation_behind_interval = 16;
+    app.foveation_stale_regions = 0;
+    app.foveation_frame = 0;
+
+    // Synthesize each eye in a separate pass (set true to emit both eyes from a single pass over each view's points)
+    app.single_pass_stereo = false;
+
+    // Issue a draw call per view (set true to submit all views with one multi-draw-indirect call)
+    app.multi_draw_indirect = false;
+
+    // Rasterize points (set true to splat C-DEP views with compute shaders)
+    app.compute_splatting = false;
+
+    // Leave disocclusion holes black (set to fill holes up to 8 pixels wide on GPU or CPU)
+    app.hole_fill = HoleFill::HOLE_FILL_NONE;
+    app.hole_fill_radius = 8;
+    app.hole_fill_threads = std::max((int)std::thread::hardware_concurrency(), 1);
+
+    // Size points to cover gaps (set true to splat 1 pixel points and fill gaps with 6 level pull-push pyramid)
+    app.pull_push_fill = false;
+    app.pull_push_depth_tolerance = 0.05;
+
+    // Splat every point (set true to cull points more than 2% behind reprojected previous frame)
+    app.hiz_culling = false;
+    app.hiz_active = false;
+    app.hiz_previous_valid = false;
+    app.hiz_tolerance = 0.02;
+
+    // Splat all points of every view (set true to skip regions filled by 2 nearest views)
+    app.occlusion_budget = false;
+    app.occlusion_budget_views = 2;
+    app.region_queries.resize(2 * ODS_REGION_GRID_X * ODS_REGION_GRID_Y);
+    glGenQueries(app.region_queries.size(), app.region_queries.data());
+
+    // GPU stage timing off by default (toggle with K)
+    gtCreateTimer(&app.gpu_timer, GPU_TIMER_RING_SIZE);
+
+    // Write each synthesized ODS image to disk
+    app.save_synthesized_views = true;
+
     // Synthesize ODS image
     //synthesizeOdsImage(app.synthesized_position);
 
@@ -435,6 +805,8 @@ void init()
 
 void render()
 {
+    CpuTraceZone zone("render");
+
     // Set viewport to entire screen
     glViewport(0, 0, app.window_width, app.window_height);
 
@@ -443,28 +815,40 @@ void render()
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glClearColor(0.1, 0.1, 0.4, 1.0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Reproject C-DEP points directly into current view (no ODS image or sphere resampling)
+    if (app.viewport_synthesis && app.ods_format == OdsFormat::CDEP)
+    {
+        gtBeginZone(&app.gpu_timer, "viewport synthesis");
+        drawViewportSynthesis(app.synthesized_position);
+        gtEndZone(&app.gpu_timer);
+        glfwSwapBuffers(app.window);
+        return;
+    }
     
     // Draw synthesized view
-    glUseProgram(app.glsl_program["depth_ods"].program);
+    gtBeginZone(&app.gpu_timer, "display");
+    GlslProgram& display = app.glsl_program[app.depth_of_field ? "depth_ods_dof" : "depth_ods"];
+    glUseProgram(display.program);
 
     glm::vec2 stereo_scale = glm::vec2(1.0, 0.5);
     glm::vec2 stereo_offset = glm::vec2(0.0, 0.0); // left
     //glm::vec2 stereo_offset = glm::vec2(0.0, 0.5); // right
 
-    glUniformMatrix4fv(app.glsl_program["depth_ods"].uniforms["modelview"], 1, GL_FALSE, glm::value_ptr(app.modelview));
-    glUniformMatrix4fv(app.glsl_program["depth_ods"].uniforms["projection"], 1, GL_FALSE, glm::value_ptr(app.projection));
-    glUniform2fv(app.glsl_program["depth_ods"].uniforms["texture_scale"], 1, glm::value_ptr(stereo_scale));
-    glUniform2fv(app.glsl_program["depth_ods"].uniforms["texture_offset"], 1, glm::value_ptr(stereo_offset));
-    glUniform1f(app.glsl_program["depth_ods"].uniforms["aperture"], app.aperture);
-    glUniform1f(app.glsl_program["depth_ods"].uniforms["focal_length"], app.focal_length);
-    glUniform1f(app.glsl_program["depth_ods"].uniforms["plane_in_focus"], app.plane_in_focus);
+    glUniformMatrix4fv(display.locations[UNIFORM_MODELVIEW], 1, GL_FALSE, glm::value_ptr(app.modelview));
+    glUniformMatrix4fv(display.locations[UNIFORM_PROJECTION], 1, GL_FALSE, glm::value_ptr(app.projection));
+    glUniform2fv(display.locations[UNIFORM_TEXTURE_SCALE], 1, glm::value_ptr(stereo_scale));
+    glUniform2fv(display.locations[UNIFORM_TEXTURE_OFFSET], 1, glm::value_ptr(stereo_offset));
+    glUniform1f(display.locations[UNIFORM_APERTURE], app.aperture);
+    glUniform1f(display.locations[UNIFORM_FOCAL_LENGTH], app.focal_length);
+    glUniform1f(display.locations[UNIFORM_PLANE_IN_FOCUS], app.plane_in_focus);
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, app.render_texture_color);
-    //glUniform1i(app.glsl_program["depth_ods"].uniforms["image"], 0); // not needed - layout in shader
+    //glUniform1i(display.locations[UNIFORM_IMAGE], 0); // not needed - layout in shader
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, app.render_texture_depth);
-    //glUniform1i(app.glsl_program["depth_ods"].uniforms["depths"], 1); // not needed - layout in shader
+    //glUniform1i(display.locations[UNIFORM_DEPTHS], 1); // not needed - layout in shader
 
     glBindVertexArray(app.sphere_vertex_array);
     glDrawElements(GL_TRIANGLES, app.num_sphere_triangles, GL_UNSIGNED_SHORT, 0);
@@ -472,15 +856,16 @@ void render()
 
     // Add cube to scene
     /*
-    glUseProgram(app.glsl_program["phong"].program);
+    GlslProgram& phong = app.glsl_program["phong"];
+    glUseProgram(phong.program);
 
-    glUniformMatrix4fv(app.glsl_program["phong"].uniforms["model"], 1, GL_FALSE, glm::value_ptr(app.cube_model_matrix));
-    glUniformMatrix4fv(app.glsl_program["phong"].uniforms["view"], 1, GL_FALSE, glm::value_ptr(app.modelview));
-    glUniformMatrix4fv(app.glsl_program["phong"].uniforms["projection"], 1, GL_FALSE, glm::value_ptr(app.projection));
+    glUniformMatrix4fv(phong.locations[UNIFORM_MODEL], 1, GL_FALSE, glm::value_ptr(app.cube_model_matrix));
+    glUniformMatrix4fv(phong.locations[UNIFORM_VIEW], 1, GL_FALSE, glm::value_ptr(app.modelview));
+    glUniformMatrix4fv(phong.locations[UNIFORM_PROJECTION], 1, GL_FALSE, glm::value_ptr(app.projection));
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, app.cube_texture);
-    glUniform1i(app.glsl_program["phong"].uniforms["image"], 0);
+    glUniform1i(phong.locations[UNIFORM_IMAGE], 0);
 
     glBindVertexArray(app.cube_vertex_array);
     glDrawElements(GL_TRIANGLES, app.num_cube_triangles, GL_UNSIGNED_SHORT, 0);
@@ -491,6 +876,7 @@ void render()
     glBindTexture(GL_TEXTURE_2D, 0);
 
     glUseProgram(0);
+    gtEndZone(&app.gpu_timer);
 
 
     glfwSwapBuffers (app.window);
@@ -498,136 +884,1134 @@ void render()
 
 void synthesizeOdsImage(glm::vec3& camera_position)
 {
-    int i, j;
+    CpuTraceZone zone("synthesizeOdsImage");
+    int j;
+
+    // C-DEP views are reprojected directly into viewport by render()
+    if (app.viewport_synthesis && app.ods_format == OdsFormat::CDEP)
+    {
+        return;
+    }
+
+    // Determine which views contribute to synthesized image
+    std::vector<int> view_indices;
+    int num_views = std::min(app.ods_num_views, app.ods_max_views);
+    if (app.ods_format == OdsFormat::DASP)
+    {
+        for (j = 0; j < num_views; j++)
+        {
+            view_indices.push_back(2 * j);
+        }
+    }
+    else
+    {
+        // Get nearest N bounding images
+        determineViews(camera_position, num_views, view_indices);
+    }
+
+    // ODS image covers every direction, so streamed views are loaded whole
+    glm::vec3 any_view_dir = glm::vec3(0.0, 0.0, -1.0);
+    for (j = 0; j < (int)view_indices.size(); j++)
+    {
+        glm::vec3 relative_cam_pos = camera_position - app.camera_positions[view_indices[j]];
+        streamOdsTiles(view_indices[j], relative_cam_pos, any_view_dir, M_PI);
+    }
+
+    // Skip synthesis if nothing changed, or reuse previous image if camera only moved slightly
+    SynthesisUpdate update = determineSynthesisUpdate(camera_position, view_indices);
+    bool foveated = app.foveated_synthesis && app.ods_format == OdsFormat::CDEP;
+    int foveation_regions = 0;
+    if (foveated)
+    {
+        // Periphery and region behind viewer keep being refreshed at a low rate after the camera stops
+        foveation_regions = scheduleFoveatedRegions(view_indices, update);
+        if (foveation_regions == 0)
+        {
+            return;
+        }
+    }
+    else if (update == SynthesisUpdate::UPDATE_NONE)
+    {
+        return;
+    }
+    if (update == SynthesisUpdate::UPDATE_INCREMENTAL)
+    {
+        // Copy previous image so it can be sampled while rendering new one
+        glCopyImageSubData(app.render_texture_color, GL_TEXTURE_2D, 0, 0, 0, 0,
+                           app.history_texture_color, GL_TEXTURE_2D, 0, 0, 0, 0,
+                           app.ods_width, 2 * app.ods_height, 1);
+        glCopyImageSubData(app.render_texture_depth, GL_TEXTURE_2D, 0, 0, 0, 0,
+                           app.history_texture_depth, GL_TEXTURE_2D, 0, 0, 0, 0,
+                           app.ods_width, 2 * app.ods_height, 1);
+    }
+
+    // Cull points hidden behind previous frame's surfaces (full C-DEP synthesis only)
+    app.hiz_active = app.hiz_culling && app.hiz_previous_valid && !foveated && app.ods_format == OdsFormat::CDEP &&
+                     update == SynthesisUpdate::UPDATE_FULL;
+    if (app.hiz_active)
+    {
+        gtBeginZone(&app.gpu_timer, "hiz pyramid");
+        buildHiZPyramid(camera_position);
+        gtEndZone(&app.gpu_timer);
+    }
+
+    // Frame constants and per-view parameters (one upload each, read by every C-DEP draw below)
+    if (app.ods_format == OdsFormat::CDEP)
+    {
+        updateFrameParamsBuffer();
+        updateViewParamsBuffer(camera_position, view_indices, view_indices.size());
+    }
 
     // Render to texture
     glBindFramebuffer(GL_FRAMEBUFFER, app.render_framebuffer);
-
-    // Delete previous frame (reset both framebuffer and z-buffer)
     glDisable(GL_BLEND);
+
+    // Foveated C-DEP (only clears and re-synthesizes scheduled regions)
+    if (foveated)
+    {
+        gtBeginZone(&app.gpu_timer, "foveated synthesis");
+        drawFoveatedOdsImage(camera_position, view_indices, foveation_regions);
+        gtEndZone(&app.gpu_timer);
+    }
+    // C-DEP compute shader splatting (always full synthesis)
+    else if (app.compute_splatting && app.ods_format == OdsFormat::CDEP)
+    {
+        gtBeginZone(&app.gpu_timer, "splat compute");
+        drawComputeSplatViews(view_indices.size());
+        gtEndZone(&app.gpu_timer);
+    }
+    // Full (or incremental) synthesis
+    else
+    {
+        drawOdsImage(camera_position, view_indices, update);
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Reconstruct gaps between 1 pixel points
+    if (app.pull_push_fill)
+    {
+        gtBeginZone(&app.gpu_timer, "pull push");
+        pullPushOdsImage();
+        gtEndZone(&app.gpu_timer);
+    }
+
+    // Fill remaining holes
+    if (app.hole_fill != HoleFill::HOLE_FILL_NONE)
+    {
+        gtBeginZone(&app.gpu_timer, "hole fill");
+        fillOdsHoles();
+        gtEndZone(&app.gpu_timer);
+    }
+
+    // Remember what was synthesized so next frame can reuse it
+    app.synthesis_cache_valid = true;
+    app.cached_position = camera_position;
+    app.cached_yaw = app.camera_yaw;
+    app.cached_pitch = app.camera_pitch;
+    app.cached_view_indices = view_indices;
+    app.history_age = (update == SynthesisUpdate::UPDATE_INCREMENTAL) ? app.history_age + 1 : 0;
+    app.hiz_previous_valid = true;
+
+    // Save synthesized image
+    if (!app.save_synthesized_views)
+    {
+        return;
+    }
+    int flip = 1;
+    uint8_t *pixels = new uint8_t[app.ods_width * app.ods_height * 8];
+    int64_t readback_start = ctNow();
+    gtBeginZone(&app.gpu_timer, "readback");
+    glBindTexture(GL_TEXTURE_2D, app.render_texture_color);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    gtEndZone(&app.gpu_timer);
+    ctRecordZone("readback", readback_start, ctNow());
+    char outname[256];
+    if (app.ods_format == OdsFormat::DASP)
+    {
+        snprintf(outname, 256, "synthesized_views/%s_%d.png", app.scene_name.c_str(), app.fc + 1);
+    }
+    else
+    {
+        snprintf(outname, 256, "synthesized_views/%s_%d.%d_%02d.png", app.scene_name.c_str(), app.ods_num_views,
+                 app.ods_max_views, app.fc + 1);
+    }
+    int64_t encode_start = ctNow();
+    iioWriteImagePng(outname, app.ods_width, app.ods_height * 2, 4, flip, pixels);
+    ctRecordZone("iioWriteImagePng", encode_start, ctNow());
+    delete[] pixels;
+}
+
+void drawOdsImage(glm::vec3& camera_position, std::vector<int>& view_indices, SynthesisUpdate update)
+{
+    int i, j;
+    char zone[48];
+
+    // Delete previous frame (reset framebuffer, z-buffer, and stencil buffer)
+    gtBeginZone(&app.gpu_timer, "clear");
     GLfloat color_bg[4] = {0.0, 0.0, 0.0, 1.0};
-    GLfloat depth_bg[1] = {1000.0};
+    GLfloat depth_bg[1] = {ODS_EMPTY_DEPTH};
     glClearBufferfv(GL_COLOR, 0, color_bg);
     glClearBufferfv(GL_COLOR, 1, depth_bg);
-    glClear(GL_DEPTH_BUFFER_BIT);
+    glClearStencil(0);
+    glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    gtEndZone(&app.gpu_timer);
+
+    int num_splat_views = view_indices.size();
+    if (update == SynthesisUpdate::UPDATE_INCREMENTAL)
+    {
+        // Forward-warp previous image (marks covered pixels in stencil buffer)
+        gtBeginZone(&app.gpu_timer, "warp previous");
+        warpPreviousOdsImage(camera_position, app.history_texture_color, app.history_texture_depth);
+        gtEndZone(&app.gpu_timer);
+
+        // Only re-splat holes and low confidence regions using the nearest views
+        glEnable(GL_STENCIL_TEST);
+        glStencilFunc(GL_EQUAL, 0, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        num_splat_views = std::min(num_splat_views, app.incremental_num_views);
+    }
 
     // DASP / SOS
     if (app.ods_format == OdsFormat::DASP)
     {
-        glUseProgram(app.glsl_program["DASP"].program);
+        GlslProgram& dasp = app.glsl_program["DASP"];
+        glUseProgram(dasp.program);
 
-        glUniform1f(app.glsl_program["DASP"].uniforms["img_ipd"], app.dasp_ipd);
-        glUniform1f(app.glsl_program["DASP"].uniforms["img_focal_dist"], app.dasp_focal_dist);
-        glUniform1f(app.glsl_program["DASP"].uniforms["camera_ipd"], 0.065);
-        glUniform1f(app.glsl_program["DASP"].uniforms["camera_focal_dist"], 1.95);
-        glUniformMatrix4fv(app.glsl_program["DASP"].uniforms["ortho_projection"], 1, GL_FALSE, glm::value_ptr(app.ods_projection));
+        glm::vec2 img_scale = glm::vec2(1.0, 1.0);
+        glm::vec2 img_offset = glm::vec2(0.0, 0.0);
 
-        int num_views = std::min(app.ods_num_views, app.ods_max_views);
+        glUniform1f(dasp.locations[UNIFORM_IMG_IPD], app.dasp_ipd);
+        glUniform1f(dasp.locations[UNIFORM_IMG_FOCAL_DIST], app.dasp_focal_dist);
+        glUniform1f(dasp.locations[UNIFORM_CAMERA_IPD], app.camera_ipd);
+        glUniform1f(dasp.locations[UNIFORM_CAMERA_FOCAL_DIST], app.camera_focal_dist);
+        glUniformMatrix4fv(dasp.locations[UNIFORM_ORTHO_PROJECTION], 1, GL_FALSE, glm::value_ptr(app.ods_projection));
+        glUniform2fv(dasp.locations[UNIFORM_TEXTURE_SCALE], 1, glm::value_ptr(img_scale));
+        glUniform2fv(dasp.locations[UNIFORM_TEXTURE_OFFSET], 1, glm::value_ptr(img_offset));
+        glUniform1f(dasp.locations[UNIFORM_EDGE_THRESHOLD], 0.0);
 
         // Draw right (bottom half of image) and left (top half of image) views
         for (i = 0; i < 2; i++)
         {
             glViewport(0, i * app.ods_height, app.ods_width, app.ods_height);
-            glUniform1f(app.glsl_program["DASP"].uniforms["camera_eye"], 2.0 * (i - 0.5));
+            glUniform1f(dasp.locations[UNIFORM_CAMERA_EYE], 2.0 * (i - 0.5));
 
-            for (j = 0; j < num_views; j++)
+            for (j = 0; j < num_splat_views; j++)
             {
-                int dasp_idx = 2 * j;
+                int dasp_idx = view_indices[j];
+                snprintf(zone, 48, "splat eye%d view%d", i, j);
+                gtBeginZone(&app.gpu_timer, zone);
                 glm::vec3 relative_cam_pos = camera_position - app.camera_positions[dasp_idx];
-                glUniform3fv(app.glsl_program["DASP"].uniforms["camera_position"], 1, glm::value_ptr(relative_cam_pos));
+                glUniform3fv(dasp.locations[UNIFORM_CAMERA_POSITION], 1, glm::value_ptr(relative_cam_pos));
 
                 // Left eye
-                glUniform1f(app.glsl_program["DASP"].uniforms["eye"], 1.0);
+                glUniform1f(dasp.locations[UNIFORM_EYE], 1.0);
                 glActiveTexture(GL_TEXTURE0);
                 glBindTexture(GL_TEXTURE_2D, app.color_textures[dasp_idx]);
-                glUniform1i(app.glsl_program["DASP"].uniforms["image"], 0);
+                glUniform1i(dasp.locations[UNIFORM_IMAGE], 0);
                 glActiveTexture(GL_TEXTURE1);
                 glBindTexture(GL_TEXTURE_2D, app.depth_textures[dasp_idx]);
-                glUniform1i(app.glsl_program["DASP"].uniforms["depths"], 1);
+                glUniform1i(dasp.locations[UNIFORM_DEPTHS], 1);
 
                 glBindVertexArray(app.ods_vertex_array);
                 glDrawArrays(GL_POINTS, 0, app.num_va_points);
                 glBindVertexArray(0);
 
                 // Right eye
-                glUniform1f(app.glsl_program["DASP"].uniforms["eye"], -1.0);
+                glUniform1f(dasp.locations[UNIFORM_EYE], -1.0);
                 glActiveTexture(GL_TEXTURE0);
                 glBindTexture(GL_TEXTURE_2D, app.color_textures[dasp_idx + 1]);
-                glUniform1i(app.glsl_program["DASP"].uniforms["image"], 0);
+                glUniform1i(dasp.locations[UNIFORM_IMAGE], 0);
                 glActiveTexture(GL_TEXTURE1);
                 glBindTexture(GL_TEXTURE_2D, app.depth_textures[dasp_idx + 1]);
-                glUniform1i(app.glsl_program["DASP"].uniforms["depths"], 1);
+                glUniform1i(dasp.locations[UNIFORM_DEPTHS], 1);
 
                 glBindVertexArray(app.ods_vertex_array);
                 glDrawArrays(GL_POINTS, 0, app.num_va_points);
                 glBindVertexArray(0);
+                gtEndZone(&app.gpu_timer);
             }
         }
     }
+    // DEP / C-DEP (all views in one call)
+    else if (app.multi_draw_indirect)
+    {
+        gtBeginZone(&app.gpu_timer, "splat indirect");
+        drawIndirectDepViews(num_splat_views);
+        gtEndZone(&app.gpu_timer);
+    }
     // DEP / C-DEP
     else
     {
-        glUseProgram(app.glsl_program["DEP"].program);
-
-        glm::mat4 view_mat1 = glm::rotate(glm::mat4(1.0), (float)(-app.camera_pitch), glm::vec3(1.0, 0.0, 0.0));
-        glm::mat4 view_mat2 = glm::rotate(glm::mat4(1.0), (float)(-app.camera_yaw), glm::vec3(0.0, 1.0, 0.0));
-        glm::vec4 xr_view_dir = view_mat2 * view_mat1 * glm::vec4(0.0, 0.0, -1.0, 1.0);
-
-        glUniform1f(app.glsl_program["DEP"].uniforms["camera_ipd"], 0.065);
-        glUniform1f(app.glsl_program["DEP"].uniforms["camera_focal_dist"], 1.95);
-        glUniform1f(app.glsl_program["DEP"].uniforms["xr_fovy"], app.fov * M_PI / 180.0);
-        glUniform1f(app.glsl_program["DEP"].uniforms["xr_aspect"], (float)app.window_width / (float)app.window_height);
-        glUniform3fv(app.glsl_program["DEP"].uniforms["xr_view_dir"], 1, glm::value_ptr(xr_view_dir));
-        glUniformMatrix4fv(app.glsl_program["DEP"].uniforms["ortho_projection"], 1, GL_FALSE, glm::value_ptr(app.ods_projection));
-
-        // Get nearest N bounding images
-        std::vector<int> view_indices;
-        int num_views = std::min(app.ods_num_views, app.ods_max_views);
-        determineViews(camera_position, num_views, view_indices);
-
         // Draw right (bottom half of image) and left (top half of image) views
-        for (i = 0; i < 2; i++)
+        bool occlusion_budget = app.occlusion_budget && update == SynthesisUpdate::UPDATE_FULL;
+        int num_passes = 2;
+        if (app.single_pass_stereo)
         {
-            glViewport(0, i * app.ods_height, app.ods_width, app.ods_height);
-            glUniform1f(app.glsl_program["DEP"].uniforms["camera_eye"], 2.0 * (i - 0.5));
+            glViewportIndexedf(0, 0.0, 0.0, app.ods_width, app.ods_height);
+            glViewportIndexedf(1, 0.0, app.ods_height, app.ods_width, app.ods_height);
+            num_passes = 1;
+        }
+        for (i = 0; i < num_passes; i++)
+        {
+            // Single pass stereo uses geometry shader to emit each point to both eyes, otherwise each eye uses its own
+            // specialized program
+            GlslProgram& dep = app.single_pass_stereo ? app.glsl_program["DEP_stereo"] :
+                               app.glsl_program[depProgramName(2.0 * (i - 0.5), app.pull_push_fill, app.hiz_active)];
+            glUseProgram(dep.program);
+            setDepFrameUniforms(dep);
+            glUniform1i(dep.locations[UNIFORM_FOVEATION_REGION], FoveationRegion::FOVEA);
+            glUniform1f(dep.locations[UNIFORM_POINT_SIZE_SCALE], 1.0);
+            if (!app.single_pass_stereo)
+            {
+                glViewport(0, i * app.ods_height, app.ods_width, app.ods_height);
+            }
 
-            for (j = 0; j < num_views; j++)
+            for (j = 0; j < num_splat_views; j++)
             {
-                glm::vec3 relative_cam_pos = camera_position - app.camera_positions[view_indices[j]];
-                glUniform1f(app.glsl_program["DEP"].uniforms["img_index"], (float)j);
-                glUniform3fv(app.glsl_program["DEP"].uniforms["camera_position"], 1, glm::value_ptr(relative_cam_pos));
+                // Remaining views only fill regions that nearer views left with holes
+                if (occlusion_budget && j == app.occlusion_budget_views)
+                {
+                    GLuint filled_regions[2] = {0, 0};
+                    gtBeginZone(&app.gpu_timer, "region query");
+                    queryFilledRegions(i, 3 - num_passes, filled_regions);
+                    gtEndZone(&app.gpu_timer);
+                    glUseProgram(dep.program);
+                    glUniform1uiv(dep.locations[UNIFORM_FILLED_REGIONS], 2, filled_regions);
+                    if (app.single_pass_stereo)
+                    {
+                        glViewportIndexedf(0, 0.0, 0.0, app.ods_width, app.ods_height);
+                        glViewportIndexedf(1, 0.0, app.ods_height, app.ods_width, app.ods_height);
+                    }
+                    else
+                    {
+                        glViewport(0, i * app.ods_height, app.ods_width, app.ods_height);
+                    }
+                }
 
+                if (app.single_pass_stereo)
+                {
+                    snprintf(zone, 48, "splat stereo view%d", j);
+                }
+                else
+                {
+                    snprintf(zone, 48, "splat eye%d view%d", i, j);
+                }
+                gtBeginZone(&app.gpu_timer, zone);
                 glActiveTexture(GL_TEXTURE0);
                 glBindTexture(GL_TEXTURE_2D, app.color_textures[view_indices[j]]);
-                glUniform1i(app.glsl_program["DEP"].uniforms["image"], 0);
                 glActiveTexture(GL_TEXTURE1);
                 glBindTexture(GL_TEXTURE_2D, app.depth_textures[view_indices[j]]);
-                glUniform1i(app.glsl_program["DEP"].uniforms["depths"], 1);
 
+                // Base instance selects view's parameters in shader
                 glBindVertexArray(app.ods_vertex_array);
-                glDrawArrays(GL_POINTS, 0, app.num_va_points);
+                glDrawArraysInstancedBaseInstance(GL_POINTS, 0, app.num_va_points, 1, j);
                 glBindVertexArray(0);
+                gtEndZone(&app.gpu_timer);
+            }
+        }
+    }
+
+    glDisable(GL_STENCIL_TEST);
+}
+
+void drawIndirectDepViews(int num_views)
+{
+    int j;
+
+    // Draw commands (base instance selects view in shader)
+    std::vector<DrawArraysIndirectCommand> commands(num_views);
+    for (j = 0; j < num_views; j++)
+    {
+        commands[j].count = app.num_va_points;
+        commands[j].instance_count = 1;
+        commands[j].first = 0;
+        commands[j].base_instance = j;
+    }
+    uploadDrawCommands(commands);
+
+    GlslProgram& dep_indirect = app.glsl_program["DEP_indirect"];
+    glUseProgram(dep_indirect.program);
+    glUniform1i(dep_indirect.locations[UNIFORM_FOVEATION_REGION], FoveationRegion::FOVEA);
+    glUniform1i(dep_indirect.locations[UNIFORM_UNIT_POINT_SIZE], app.pull_push_fill);
+    setCullingUniforms(dep_indirect);
+    glUniform1f(dep_indirect.locations[UNIFORM_POINT_SIZE_SCALE], 1.0);
+
+    // All views are layers of the same texture arrays
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, app.color_texture_array);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, app.depth_texture_array);
+
+    // Right eye to bottom half of image (viewport 0), left eye to top half of image (viewport 1)
+    glViewportIndexedf(0, 0.0, 0.0, app.ods_width, app.ods_height);
+    glViewportIndexedf(1, 0.0, app.ods_height, app.ods_width, app.ods_height);
+
+    glBindVertexArray(app.ods_vertex_array);
+    glMultiDrawArraysIndirect(GL_POINTS, 0, num_views, 0);
+    glBindVertexArray(0);
+
+    // Unbind buffers and textures
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void drawComputeSplatViews(int num_views)
+{
+    GLuint groups_x = (app.ods_width + 7) / 8;
+    GLuint groups_y = (app.ods_height + 7) / 8;
+    glm::uvec2 out_dims = glm::uvec2(app.ods_width, 2 * app.ods_height);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, app.splat_buffer);
+
+    // Clear RGB-D buffer (both eyes)
+    GlslProgram& splat_clear = app.glsl_program["ODS_splat_clear"];
+    glUseProgram(splat_clear.program);
+    glUniform2uiv(splat_clear.locations[UNIFORM_DIMS], 1, glm::value_ptr(out_dims));
+    glDispatchCompute(groups_x, 2 * groups_y, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Splat all views (one invocation per input pixel, z selects view)
+    GlslProgram& dep_splat = app.glsl_program["DEP_splat"];
+    glUseProgram(dep_splat.program);
+    glUniform1f(dep_splat.locations[UNIFORM_MAX_DEPTH], app.splat_max_depth);
+    setCullingUniforms(dep_splat);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, app.color_texture_array);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, app.depth_texture_array);
+
+    glDispatchCompute(groups_x, groups_y, num_views);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Resolve RGB-D buffer to render textures
+    GlslProgram& splat_resolve = app.glsl_program["ODS_splat_resolve"];
+    glUseProgram(splat_resolve.program);
+    glUniform2uiv(splat_resolve.locations[UNIFORM_DIMS], 1, glm::value_ptr(out_dims));
+    glUniform1f(splat_resolve.locations[UNIFORM_MAX_DEPTH], app.splat_max_depth);
+    glBindImageTexture(0, app.render_texture_color, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+    glBindImageTexture(1, app.render_texture_depth, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glDispatchCompute(groups_x, 2 * groups_y, 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+    glBindImageTexture(1, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+}
+
+void updateViewParamsBuffer(glm::vec3& camera_position, std::vector<int>& view_indices, int num_views)
+{
+    int j;
+    std::vector<OdsViewParams> view_params(num_views);
+    for (j = 0; j < num_views; j++)
+    {
+        glm::vec3 relative_cam_pos = camera_position - app.camera_positions[view_indices[j]];
+        view_params[j].camera_position[0] = relative_cam_pos[0];
+        view_params[j].camera_position[1] = relative_cam_pos[1];
+        view_params[j].camera_position[2] = relative_cam_pos[2];
+        view_params[j].img_index = (float)j;
+        view_params[j].layer = view_indices[j];
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, app.view_params_buffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, num_views * sizeof(OdsViewParams), view_params.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, app.view_params_buffer);
+}
+
+void updateFrameParamsBuffer()
+{
+    glm::vec3 xr_view_dir;
+    float diagonal_fov;
+    getXrViewCone(xr_view_dir, diagonal_fov);
+
+    OdsFrameParams frame_params;
+    memcpy(frame_params.ortho_projection, glm::value_ptr(app.ods_projection), 16 * sizeof(GLfloat));
+    frame_params.xr_view_dir[0] = xr_view_dir[0];
+    frame_params.xr_view_dir[1] = xr_view_dir[1];
+    frame_params.xr_view_dir[2] = xr_view_dir[2];
+    frame_params.camera_ipd = app.camera_ipd;
+    frame_params.camera_focal_dist = app.camera_focal_dist;
+    frame_params.xr_fovy = app.fov * M_PI / 180.0;
+    frame_params.xr_aspect = (float)app.window_width / (float)app.window_height;
+    frame_params.foveation_behind_angle = app.foveation_behind_angle;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, app.frame_params_buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(OdsFrameParams), &frame_params);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, app.frame_params_buffer);
+}
+
+// Leaves draw indirect buffer bound (grown when commands do not fit)
+void uploadDrawCommands(std::vector<DrawArraysIndirectCommand>& commands)
+{
+    GLsizeiptr size = commands.size() * sizeof(DrawArraysIndirectCommand);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, app.draw_indirect_buffer);
+    if (size > app.draw_indirect_capacity)
+    {
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+        app.draw_indirect_capacity = size;
+    }
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, commands.data());
+}
+
+void fillOdsHoles()
+{
+    int i;
+
+    // CPU: read back render targets, dilate, and upload result
+    if (app.hole_fill == HoleFill::HOLE_FILL_CPU)
+    {
+        int num_pixels = 2 * app.ods_width * app.ods_height;
+        uint8_t *color = new uint8_t[4 * num_pixels];
+        float *depth = new float[num_pixels];
+        glBindTexture(GL_TEXTURE_2D, app.render_texture_color);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, color);
+        glBindTexture(GL_TEXTURE_2D, app.render_texture_depth);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, depth);
+
+        hfFillHoles(color, depth, app.ods_width, app.ods_height, 2, ODS_EMPTY_DEPTH, app.hole_fill_radius,
+                    app.hole_fill_threads);
+
+        glBindTexture(GL_TEXTURE_2D, app.render_texture_color);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, app.ods_width, 2 * app.ods_height, GL_RGBA, GL_UNSIGNED_BYTE, color);
+        glBindTexture(GL_TEXTURE_2D, app.render_texture_depth);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, app.ods_width, 2 * app.ods_height, GL_RED, GL_FLOAT, depth);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        delete[] color;
+        delete[] depth;
+        return;
+    }
+
+    // GPU: fill into hole fill textures, then copy result back to render textures
+    glm::ivec2 dims = glm::ivec2(app.ods_width, app.ods_height);
+    GlslProgram& hole_fill = app.glsl_program["ODS_hole_fill"];
+    glUseProgram(hole_fill.program);
+    glUniform2iv(hole_fill.locations[UNIFORM_DIMS], 1, glm::value_ptr(dims));
+    glUniform1i(hole_fill.locations[UNIFORM_RADIUS], app.hole_fill_radius);
+    glBindImageTexture(0, app.render_texture_color, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA8);
+    glBindImageTexture(1, app.render_texture_depth, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glBindImageTexture(2, app.holefill_texture_color, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+    glBindImageTexture(3, app.holefill_texture_depth, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glDispatchCompute((app.ods_width + 7) / 8, (2 * app.ods_height + 7) / 8, 1);
+    glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+    glCopyImageSubData(app.holefill_texture_color, GL_TEXTURE_2D, 0, 0, 0, 0,
+                       app.render_texture_color, GL_TEXTURE_2D, 0, 0, 0, 0,
+                       app.ods_width, 2 * app.ods_height, 1);
+    glCopyImageSubData(app.holefill_texture_depth, GL_TEXTURE_2D, 0, 0, 0, 0,
+                       app.render_texture_depth, GL_TEXTURE_2D, 0, 0, 0, 0,
+                       app.ods_width, 2 * app.ods_height, 1);
+
+    for (i = 0; i < 4; i++)
+    {
+        glBindImageTexture(i, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    }
+    glUseProgram(0);
+}
+
+void pullPushOdsImage()
+{
+    int i;
+    int levels = ODS_PULL_PUSH_LEVELS;
+    std::vector<glm::ivec2> dims(levels + 1);
+    dims[0] = glm::ivec2(app.ods_width, 2 * app.ods_height);
+    for (i = 1; i <= levels; i++)
+    {
+        dims[i] = glm::ivec2(std::max(dims[i - 1].x / 2, 1), std::max(dims[i - 1].y / 2, 1));
+    }
+
+    // Level 0 is the render target, level i > 0 is mip level i - 1 of pull-push textures
+    GLuint color_textures[2] = {app.render_texture_color, app.pullpush_texture_color};
+    GLuint depth_textures[2] = {app.render_texture_depth, app.pullpush_texture_depth};
+
+    // Pull: average front-most samples into coarser levels
+    GlslProgram& pull = app.glsl_program["ODS_pull"];
+    glUseProgram(pull.program);
+    glUniform1f(pull.locations[UNIFORM_DEPTH_TOLERANCE], app.pull_push_depth_tolerance);
+    for (i = 1; i <= levels; i++)
+    {
+        int src = std::min(i - 1, 1);
+        int src_mip = std::max(i - 2, 0);
+        glUniform2iv(pull.locations[UNIFORM_SRC_DIMS], 1, glm::value_ptr(dims[i - 1]));
+        glUniform2iv(pull.locations[UNIFORM_DST_DIMS], 1, glm::value_ptr(dims[i]));
+        glBindImageTexture(0, color_textures[src], src_mip, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA8);
+        glBindImageTexture(1, depth_textures[src], src_mip, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        glBindImageTexture(2, app.pullpush_texture_color, i - 1, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+        glBindImageTexture(3, app.pullpush_texture_depth, i - 1, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((dims[i].x + 7) / 8, (dims[i].y + 7) / 8, 1);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    }
+
+    // Push: fill gaps in each level from next coarser level (ends at render target)
+    GlslProgram& push = app.glsl_program["ODS_push"];
+    glUseProgram(push.program);
+    for (i = levels - 1; i >= 0; i--)
+    {
+        int dst = std::min(i, 1);
+        int dst_mip = std::max(i - 1, 0);
+        glUniform2iv(push.locations[UNIFORM_SRC_DIMS], 1, glm::value_ptr(dims[i + 1]));
+        glUniform2iv(push.locations[UNIFORM_DST_DIMS], 1, glm::value_ptr(dims[i]));
+        glBindImageTexture(0, app.pullpush_texture_color, i, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA8);
+        glBindImageTexture(1, app.pullpush_texture_depth, i, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        glBindImageTexture(2, color_textures[dst], dst_mip, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA8);
+        glBindImageTexture(3, depth_textures[dst], dst_mip, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+        glDispatchCompute((dims[i].x + 7) / 8, (dims[i].y + 7) / 8, 1);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    }
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+
+    for (i = 0; i < 4; i++)
+    {
+        glBindImageTexture(i, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    }
+    glUseProgram(0);
+}
+
+SynthesisUpdate determineSynthesisUpdate(glm::vec3& camera_position, std::vector<int>& view_indices)
+{
+    if (!app.synthesis_cache_valid)
+    {
+        return SynthesisUpdate::UPDATE_FULL;
+    }
+
+    // C-DEP only synthesizes points inside the XR viewport, so view direction is part of the cache key
+    bool same_views = (view_indices == app.cached_view_indices);
+    bool same_direction = (app.ods_format == OdsFormat::DASP) ||
+                          (app.camera_yaw == app.cached_yaw && app.camera_pitch == app.cached_pitch);
+    float motion = glm::distance(camera_position, app.cached_position);
+    if (same_views && same_direction && motion == 0.0)
+    {
+        return SynthesisUpdate::UPDATE_NONE;
+    }
+    bool foveated = app.foveated_synthesis && app.ods_format == OdsFormat::CDEP;
+    bool compute = app.compute_splatting && app.ods_format == OdsFormat::CDEP;
+    if (app.incremental_synthesis && !foveated && !compute && same_views && same_direction &&
+        motion <= app.incremental_max_distance && app.history_age < app.incremental_max_age)
+    {
+        return SynthesisUpdate::UPDATE_INCREMENTAL;
+    }
+    return SynthesisUpdate::UPDATE_FULL;
+}
+
+void warpPreviousOdsImage(glm::vec3& camera_position, GLuint color_texture, GLuint depth_texture)
+{
+    int i, j;
+
+    GlslProgram& dasp = app.glsl_program["DASP"];
+    glUseProgram(dasp.program);
+
+    // Previous image was synthesized with the same ODS camera, so it can be reprojected as a DASP image pair
+    glm::vec3 relative_cam_pos = camera_position - app.cached_position;
+    glUniform1f(dasp.locations[UNIFORM_IMG_IPD], app.camera_ipd);
+    glUniform1f(dasp.locations[UNIFORM_IMG_FOCAL_DIST], app.camera_focal_dist);
+    glUniform1f(dasp.locations[UNIFORM_CAMERA_IPD], app.camera_ipd);
+    glUniform1f(dasp.locations[UNIFORM_CAMERA_FOCAL_DIST], app.camera_focal_dist);
+    glUniform3fv(dasp.locations[UNIFORM_CAMERA_POSITION], 1, glm::value_ptr(relative_cam_pos));
+    glUniformMatrix4fv(dasp.locations[UNIFORM_ORTHO_PROJECTION], 1, GL_FALSE, glm::value_ptr(app.ods_projection));
+    glUniform1f(dasp.locations[UNIFORM_EDGE_THRESHOLD], app.incremental_edge_threshold);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, color_texture);
+    glUniform1i(dasp.locations[UNIFORM_IMAGE], 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, depth_texture);
+    glUniform1i(dasp.locations[UNIFORM_DEPTHS], 1);
+
+    // Mark every pixel covered by a warped point
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(GL_ALWAYS, 1, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+
+    // Previous image is flipped vertically, with left eye in top half and right eye in bottom half
+    glm::vec2 history_scale = glm::vec2(1.0, -0.5);
+    for (i = 0; i < 2; i++)
+    {
+        glViewport(0, i * app.ods_height, app.ods_width, app.ods_height);
+        glUniform1f(dasp.locations[UNIFORM_CAMERA_EYE], 2.0 * (i - 0.5));
+
+        for (j = 0; j < 2; j++)
+        {
+            glm::vec2 history_offset = glm::vec2(0.0, 0.5 * (j + 1));
+            glUniform1f(dasp.locations[UNIFORM_EYE], 2.0 * (j - 0.5));
+            glUniform2fv(dasp.locations[UNIFORM_TEXTURE_SCALE], 1, glm::value_ptr(history_scale));
+            glUniform2fv(dasp.locations[UNIFORM_TEXTURE_OFFSET], 1, glm::value_ptr(history_offset));
+
+            glBindVertexArray(app.ods_vertex_array);
+            glDrawArrays(GL_POINTS, 0, app.num_va_points);
+            glBindVertexArray(0);
+        }
+    }
+
+    glDisable(GL_STENCIL_TEST);
+}
+
+void buildHiZPyramid(glm::vec3& camera_position)
+{
+    int i;
+
+    // Forward-warp previous image's depth to current position (holes stay empty, so they never occlude)
+    glBindFramebuffer(GL_FRAMEBUFFER, app.hiz_framebuffer);
+    glDisable(GL_BLEND);
+    GLfloat depth_bg[1] = {ODS_EMPTY_DEPTH};
+    glClearBufferfv(GL_COLOR, 1, depth_bg);
+    glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    warpPreviousOdsImage(camera_position, app.render_texture_color, app.render_texture_depth);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Reduce to max depth of each coarser texel
+    glm::ivec2 src_dims = glm::ivec2(app.ods_width, 2 * app.ods_height);
+    GlslProgram& hiz_reduce = app.glsl_program["ODS_hiz_reduce"];
+    glUseProgram(hiz_reduce.program);
+    for (i = 1; i < app.hiz_levels; i++)
+    {
+        glm::ivec2 dst_dims = glm::ivec2(std::max(src_dims.x / 2, 1), std::max(src_dims.y / 2, 1));
+        glUniform2iv(hiz_reduce.locations[UNIFORM_SRC_DIMS], 1, glm::value_ptr(src_dims));
+        glUniform2iv(hiz_reduce.locations[UNIFORM_DST_DIMS], 1, glm::value_ptr(dst_dims));
+        glBindImageTexture(0, app.hiz_texture, i - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        glBindImageTexture(1, app.hiz_texture, i, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((dst_dims.x + 7) / 8, (dst_dims.y + 7) / 8, 1);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        src_dims = dst_dims;
+    }
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glBindImageTexture(1, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+void setCullingUniforms(GlslProgram& program)
+{
+    GLuint no_regions[2] = {0, 0};
+    glUniform2i(program.locations[UNIFORM_REGION_GRID], ODS_REGION_GRID_X, ODS_REGION_GRID_Y);
+    glUniform1uiv(program.locations[UNIFORM_FILLED_REGIONS], 2, no_regions);
+    glUniform1i(program.locations[UNIFORM_HIZ_CULLING], app.hiz_active);
+    glUniform1f(program.locations[UNIFORM_HIZ_TOLERANCE], app.hiz_tolerance);
+    glUniform1i(program.locations[UNIFORM_HIZ_MAX_LEVEL], app.hiz_levels - 1);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, app.hiz_texture);
+    glUniform1i(program.locations[UNIFORM_HIZ_DEPTH], 2);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+// DEP programs specialized for each eye, point size mode, and hierarchical-Z culling (no per-point branches on them)
+void loadDepVariants()
+{
+    int eye, unit_point_size, hiz_culling;
+    for (eye = 0; eye < 2; eye++)
+    {
+        for (unit_point_size = 0; unit_point_size < 2; unit_point_size++)
+        {
+            for (hiz_culling = 0; hiz_culling < 2; hiz_culling++)
+            {
+                std::vector<std::string> defines;
+                defines.push_back(eye == 0 ? "CAMERA_EYE -1.0" : "CAMERA_EYE 1.0");
+                defines.push_back(unit_point_size ? "UNIT_POINT_SIZE true" : "UNIT_POINT_SIZE false");
+                defines.push_back(hiz_culling ? "HIZ_CULLING true" : "HIZ_CULLING false");
+
+                GlslProgram dep;
+                dep.program = glsl::createShaderProgram("./resrc/shaders/dep.vert", "./resrc/shaders/dep.frag", defines,
+                                                        std::vector<std::string>(1, DEP_SHADER_HEADER));
+                glsl::linkShaderProgram(dep.program);
+                glsl::getShaderProgramUniforms(dep.program, dep.uniforms);
+                app.glsl_program[depProgramName(2.0 * (eye - 0.5), unit_point_size, hiz_culling)] = dep;
             }
         }
     }
+}
+
+void resolveUniformLocations(GlslProgram& program)
+{
+    int i;
+    for (i = 0; i < NUM_UNIFORMS; i++)
+    {
+        std::map<std::string,GLint>::iterator it = program.uniforms.find(uniform_names[i]);
+        program.locations[i] = (it != program.uniforms.end()) ? it->second : -1;
+    }
+}
+
+// Swaps in programs rebuilt from edited shader files (program keeps its name, uniforms are looked up again)
+void reloadChangedShaders()
+{
+    std::vector<std::pair<GLuint,GLuint>> reloaded;
+    if (glsl::reloadChangedPrograms(reloaded) == 0)
+    {
+        return;
+    }
+
+    size_t i;
+    std::map<std::string,GlslProgram>::iterator it;
+    for (i = 0; i < reloaded.size(); i++)
+    {
+        for (it = app.glsl_program.begin(); it != app.glsl_program.end(); it++)
+        {
+            if (it->second.program == reloaded[i].first)
+            {
+                it->second.program = reloaded[i].second;
+                it->second.uniforms.clear();
+                glsl::getShaderProgramUniforms(it->second.program, it->second.uniforms);
+                resolveUniformLocations(it->second);
+            }
+        }
+    }
+    app.synthesis_cache_valid = false;
+}
+
+std::string depProgramName(float eye, bool unit_point_size, bool hiz_culling)
+{
+    return std::string("DEP") + (eye > 0.0 ? "_left" : "_right") + (unit_point_size ? "_unit" : "") +
+           (hiz_culling ? "_hiz" : "");
+}
+
+// Frame constants and per-view parameters are read from buffers, only program's own uniforms are set here
+void setDepFrameUniforms(GlslProgram& program)
+{
+    glUniform1i(program.locations[UNIFORM_UNIT_POINT_SIZE], app.pull_push_fill);
+    setCullingUniforms(program);
+    glUniform1i(program.locations[UNIFORM_IMAGE], 0);
+    glUniform1i(program.locations[UNIFORM_DEPTHS], 1);
+}
+
+void queryFilledRegions(int first_eye, int num_eyes, GLuint *filled_regions)
+{
+    int eye, x, y;
+
+    // Count samples of each region that are still empty (depth buffer at clear value), without writing anything
+    glUseProgram(app.glsl_program["ods_hole_query"].program);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LEQUAL);
+    glEnable(GL_SCISSOR_TEST);
+    glBindVertexArray(app.empty_vertex_array);
+    for (eye = first_eye; eye < first_eye + num_eyes; eye++)
+    {
+        glViewport(0, eye * app.ods_height, app.ods_width, app.ods_height);
+        for (y = 0; y < ODS_REGION_GRID_Y; y++)
+        {
+            for (x = 0; x < ODS_REGION_GRID_X; x++)
+            {
+                int x0 = (x * app.ods_width) / ODS_REGION_GRID_X;
+                int x1 = ((x + 1) * app.ods_width) / ODS_REGION_GRID_X;
+                int y0 = (y * app.ods_height) / ODS_REGION_GRID_Y;
+                int y1 = ((y + 1) * app.ods_height) / ODS_REGION_GRID_Y;
+                int region = (eye * ODS_REGION_GRID_Y + y) * ODS_REGION_GRID_X + x;
+                glScissor(x0, eye * app.ods_height + y0, x1 - x0, y1 - y0);
+                glBeginQuery(GL_ANY_SAMPLES_PASSED, app.region_queries[region]);
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+                glEndQuery(GL_ANY_SAMPLES_PASSED);
+            }
+        }
+    }
+    glBindVertexArray(0);
+    glDisable(GL_SCISSOR_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    // Regions without any empty samples are filled (waits for queries to finish)
+    for (eye = first_eye; eye < first_eye + num_eyes; eye++)
+    {
+        for (y = 0; y < ODS_REGION_GRID_Y; y++)
+        {
+            for (x = 0; x < ODS_REGION_GRID_X; x++)
+            {
+                int region = (eye * ODS_REGION_GRID_Y + y) * ODS_REGION_GRID_X + x;
+                GLuint any_empty;
+                glGetQueryObjectuiv(app.region_queries[region], GL_QUERY_RESULT, &any_empty);
+                if (!any_empty)
+                {
+                    filled_regions[region / 32] |= (1u << (region % 32));
+                }
+            }
+        }
+    }
+}
+
+int scheduleFoveatedRegions(std::vector<int>& view_indices, SynthesisUpdate update)
+{
+    // XR viewport is re-synthesized whenever something changed, periphery and region behind viewer
+    // are refreshed at lower rates until they have caught up with latest change
+    int regions = 0;
+    if (update != SynthesisUpdate::UPDATE_NONE)
+    {
+        regions |= (1 << FoveationRegion::FOVEA);
+        app.foveation_stale_regions = (1 << FoveationRegion::PERIPHERY) | (1 << FoveationRegion::BEHIND);
+    }
+    if (!app.synthesis_cache_valid || view_indices != app.cached_view_indices)
+    {
+        regions = (1 << FoveationRegion::FOVEA) | (1 << FoveationRegion::PERIPHERY) | (1 << FoveationRegion::BEHIND);
+    }
+    else
+    {
+        if ((app.foveation_stale_regions & (1 << FoveationRegion::PERIPHERY)) &&
+            app.foveation_frame % app.foveation_periphery_interval == 0)
+        {
+            regions |= (1 << FoveationRegion::PERIPHERY);
+        }
+        if ((app.foveation_stale_regions & (1 << FoveationRegion::BEHIND)) &&
+            app.foveation_frame % app.foveation_behind_interval == 0)
+        {
+            regions |= (1 << FoveationRegion::BEHIND);
+        }
+    }
+    app.foveation_stale_regions &= ~regions;
+    app.foveation_frame++;
+
+    return regions;
+}
+
+void drawFoveatedOdsImage(glm::vec3& camera_position, std::vector<int>& view_indices, int regions)
+{
+    int i, j, r;
+
+    glm::vec3 xr_view_dir;
+    float diagonal_fov;
+    getXrViewCone(xr_view_dir, diagonal_fov);
+
+    // Clear regions that will be re-synthesized (color, depth, and z-buffer)
+    glDepthFunc(GL_ALWAYS);
+    GlslProgram& ods_clear = app.glsl_program["ods_clear"];
+    glUseProgram(ods_clear.program);
+
+    glUniform1i(ods_clear.locations[UNIFORM_CLEAR_REGIONS], regions);
+
+    glBindVertexArray(app.empty_vertex_array);
+    for (i = 0; i < 2; i++)
+    {
+        glm::vec2 viewport_origin = glm::vec2(0.0, i * app.ods_height);
+        glm::vec2 viewport_size = glm::vec2(app.ods_width, app.ods_height);
+        glViewport(0, i * app.ods_height, app.ods_width, app.ods_height);
+        glUniform2fv(ods_clear.locations[UNIFORM_VIEWPORT_ORIGIN], 1, glm::value_ptr(viewport_origin));
+        glUniform2fv(ods_clear.locations[UNIFORM_VIEWPORT_SIZE], 1, glm::value_ptr(viewport_size));
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    glBindVertexArray(0);
+    glDepthFunc(GL_LESS);
+
+    // Gather tiles of each view that may project into each region being synthesized
+    int num_views = view_indices.size();
+    std::vector<std::vector<GLint>> tile_firsts(3 * num_views);
+    std::vector<std::vector<GLsizei>> tile_counts(3 * num_views);
+    for (j = 0; j < num_views; j++)
+    {
+        glm::vec3 relative_cam_pos = camera_position - app.camera_positions[view_indices[j]];
+        for (r = 0; r < 3; r++)
+        {
+            if (regions & (1 << r))
+            {
+                gatherFoveatedTiles(view_indices[j], relative_cam_pos, xr_view_dir, diagonal_fov, r,
+                                    tile_firsts[3 * j + r], tile_counts[3 * j + r]);
+            }
+        }
+    }
+
+    // One draw command per tile (base instance selects view in shader), uploaded once and shared by both eyes
+    std::vector<DrawArraysIndirectCommand> commands;
+    std::vector<size_t> list_offsets(3 * num_views + 1, 0);
+    int list;
+    size_t t;
+    for (list = 0; list < 3 * num_views; list++)
+    {
+        for (t = 0; t < tile_firsts[list].size(); t++)
+        {
+            DrawArraysIndirectCommand command;
+            command.count = tile_counts[list][t];
+            command.instance_count = 1;
+            command.first = tile_firsts[list][t];
+            command.base_instance = list / 3;
+            commands.push_back(command);
+        }
+        list_offsets[list + 1] = commands.size();
+    }
+    if (commands.size() == 0)
+    {
+        return;
+    }
+    uploadDrawCommands(commands);
+
+    // Synthesize XR viewport at full point density, periphery at 1/4 and region behind viewer at 1/16
+    // Draw right (bottom half of image) and left (top half of image) views
+    for (i = 0; i < 2; i++)
+    {
+        GlslProgram& dep = app.glsl_program[depProgramName(2.0 * (i - 0.5), app.pull_push_fill, app.hiz_active)];
+        glUseProgram(dep.program);
+        setDepFrameUniforms(dep);
+        glViewport(0, i * app.ods_height, app.ods_width, app.ods_height);
+
+        for (j = 0; j < num_views; j++)
+        {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, app.color_textures[view_indices[j]]);
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, app.depth_textures[view_indices[j]]);
+
+            glBindVertexArray(app.ods_vertex_array);
+            for (r = 0; r < 3; r++)
+            {
+                list = 3 * j + r;
+                GLsizei num_commands = list_offsets[list + 1] - list_offsets[list];
+                if (num_commands > 0)
+                {
+                    glUniform1i(dep.locations[UNIFORM_FOVEATION_REGION], r);
+                    glUniform1f(dep.locations[UNIFORM_POINT_SIZE_SCALE], (float)(1 << r));
+                    glMultiDrawArraysIndirect(GL_POINTS,
+                                              (void*)(list_offsets[list] * sizeof(DrawArraysIndirectCommand)),
+                                              num_commands, 0);
+                }
+            }
+            glBindVertexArray(0);
+        }
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void gatherFoveatedTiles(int view_index, glm::vec3& relative_cam_pos, glm::vec3& view_dir, float diagonal_fov,
+                         int region, std::vector<GLint>& firsts, std::vector<GLsizei>& counts)
+{
+    size_t t;
+    double baseline = glm::length(relative_cam_pos);
+    for (t = 0; t < app.ods_tiles.size(); t++)
+    {
+        // Streamed tiles that are not uploaded yet have undefined texels
+        if (app.stream_tiles && !app.stream_resident[view_index][app.stream_tile_of_ods_tile[t]])
+        {
+            continue;
+        }
+
+        OdsTile& tile = app.ods_tiles[t];
+        double margin = tileViewMargin(tile.radius, app.tile_min_depths[view_index][t], baseline);
+        double angle = acos(std::max(-1.0f, std::min(glm::dot(tile.direction, view_dir), 1.0f)));
+
+        bool visible;
+        if (region == FoveationRegion::FOVEA)
+        {
+            visible = (angle - margin) < diagonal_fov;
+        }
+        else if (region == FoveationRegion::PERIPHERY)
+        {
+            visible = (angle + margin) >= diagonal_fov && (angle - margin) < app.foveation_behind_angle;
+        }
+        else
+        {
+            visible = (angle + margin) >= app.foveation_behind_angle;
+        }
+
+        if (visible)
+        {
+            firsts.push_back(tile.first);
+            counts.push_back(tile.count[region]);
+        }
+    }
+}
+
+void drawViewportSynthesis(glm::vec3& camera_position)
+{
+    int j;
+
+    // Get nearest N bounding images
+    std::vector<int> view_indices;
+    int num_views = std::min(app.ods_num_views, app.ods_max_views);
+    determineViews(camera_position, num_views, view_indices);
+
+    glm::vec3 xr_view_dir;
+    float diagonal_fov;
+    getXrViewCone(xr_view_dir, diagonal_fov);
+
+    // Scale point size by ratio of viewport pixel density to ODS image pixel density
+    float pixel_scale = (app.window_height / (2.0 * tan(0.5 * app.fov * M_PI / 180.0))) / (app.ods_height / M_PI);
+
+    glDisable(GL_BLEND);
+    GlslProgram& dep_viewport = app.glsl_program["DEP_viewport"];
+    glUseProgram(dep_viewport.program);
+
+    glUniform1f(dep_viewport.locations[UNIFORM_CAMERA_IPD], app.camera_ipd);
+    glUniform1f(dep_viewport.locations[UNIFORM_CAMERA_EYE], -1.0); // same eye as ODS display
+    glUniform1f(dep_viewport.locations[UNIFORM_PIXEL_SCALE], pixel_scale);
+    glUniformMatrix4fv(dep_viewport.locations[UNIFORM_MODELVIEW], 1, GL_FALSE, glm::value_ptr(app.modelview));
+    glUniformMatrix4fv(dep_viewport.locations[UNIFORM_PROJECTION], 1, GL_FALSE, glm::value_ptr(app.projection));
+
+    glBindVertexArray(app.ods_vertex_array);
+    for (j = 0; j < num_views; j++)
+    {
+        glm::vec3 relative_cam_pos = camera_position - app.camera_positions[view_indices[j]];
+        glUniform1f(dep_viewport.locations[UNIFORM_IMG_INDEX], (float)j);
+        glUniform3fv(dep_viewport.locations[UNIFORM_CAMERA_POSITION], 1, glm::value_ptr(relative_cam_pos));
+        streamOdsTiles(view_indices[j], relative_cam_pos, xr_view_dir, diagonal_fov);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, app.color_textures[view_indices[j]]);
+        glUniform1i(dep_viewport.locations[UNIFORM_IMAGE], 0);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, app.depth_textures[view_indices[j]]);
+        glUniform1i(dep_viewport.locations[UNIFORM_DEPTHS], 1);
+
+        // Only draw tiles that may project into view frustum
+        std::vector<GLint> tile_firsts;
+        std::vector<GLsizei> tile_counts;
+        gatherFoveatedTiles(view_indices[j], relative_cam_pos, xr_view_dir, diagonal_fov, FoveationRegion::FOVEA,
+                            tile_firsts, tile_counts);
+        if (tile_firsts.size() > 0)
+        {
+            glMultiDrawArrays(GL_POINTS, tile_firsts.data(), tile_counts.data(), tile_firsts.size());
+        }
+    }
+    glBindVertexArray(0);
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, 0);
     glUseProgram(0);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
 
-    
-    int flip = 1;
-    uint8_t *pixels = new uint8_t[app.ods_width * app.ods_height * 8];
-    glBindTexture(GL_TEXTURE_2D, app.render_texture_color);
-    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    char outname[96];
-    //snprintf(outname, 96, "synthesized_views/office_ods_dasp_4k_%d.png", app.fc + 1);
-    snprintf(outname, 96, "synthesized_views/office_ods_sos_4k_%d.png", app.fc + 1);
-    //snprintf(outname, 96, "synthesized_views/office_ods_cdep_%d.%d_%02d.png", app.ods_num_views, app.ods_max_views, app.fc + 1);
-    iioWriteImagePng(outname, app.ods_width, app.ods_height * 2, 4, flip, pixels);
-    delete[] pixels;
+// Center direction and angular radius of a pixel rectangle of an ODS image
+void computeTileBounds(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, glm::vec3& direction, float& radius)
+{
+    double azimuth0 = 2.0 * M_PI * (1.0 - (x1 / (double)app.ods_width));
+    double azimuth1 = 2.0 * M_PI * (1.0 - (x0 / (double)app.ods_width));
+    double inclination0 = M_PI * (y0 / (double)app.ods_height);
+    double inclination1 = M_PI * (y1 / (double)app.ods_height);
+    double center_azimuth = 0.5 * (azimuth0 + azimuth1);
+    double center_inclination = 0.5 * (inclination0 + inclination1);
+    double max_sin_inclination = (inclination0 <= 0.5 * M_PI && inclination1 >= 0.5 * M_PI) ? 1.0 :
+                                 std::max(sin(inclination0), sin(inclination1));
+    direction = glm::vec3(sin(center_inclination) * sin(center_azimuth),
+                          cos(center_inclination),
+                          sin(center_inclination) * cos(center_azimuth));
+    radius = 0.5 * ((inclination1 - inclination0) + (azimuth1 - azimuth0) * max_sin_inclination);
+}
+
+// Max angle a tile's points can shift when seen from synthesized camera (parallax and eye offset), plus tile radius
+double tileViewMargin(float radius, double min_depth, double baseline)
+{
+    double half_ipd = 0.5 * app.camera_ipd;
+    double eye_angle = asin(half_ipd / app.camera_focal_dist);
+    double parallax = (baseline < min_depth) ? asin(baseline / min_depth) : M_PI;
+    double eye_offset = (half_ipd < min_depth) ? asin(half_ipd / min_depth) : M_PI;
+    return radius + parallax + eye_offset + eye_angle;
+}
+
+void getXrViewCone(glm::vec3& view_dir, float& diagonal_fov)
+{
+    // View direction and cone bounding XR viewport (same as DEP shader)
+    glm::mat4 view_mat1 = glm::rotate(glm::mat4(1.0), (float)(-app.camera_pitch), glm::vec3(1.0, 0.0, 0.0));
+    glm::mat4 view_mat2 = glm::rotate(glm::mat4(1.0), (float)(-app.camera_yaw), glm::vec3(0.0, 1.0, 0.0));
+    view_dir = glm::vec3(view_mat2 * view_mat1 * glm::vec4(0.0, 0.0, -1.0, 1.0));
+
+    float xr_fovy = app.fov * M_PI / 180.0;
+    float xr_aspect = (float)app.window_width / (float)app.window_height;
+    diagonal_fov = atan(tan(0.5 * xr_fovy + 0.005) * sqrt(xr_aspect * xr_aspect + 1.0));
 }
 
 void onResize(GLFWwindow *window, int width, int height)
@@ -636,6 +2020,9 @@ void onResize(GLFWwindow *window, int width, int height)
     app.window_height = height;
 
     app.projection = glm::perspective(app.fov * M_PI / 180.0, (double)app.window_width / (double)app.window_height, 0.1, 100.0);
+
+    // XR viewport changed - previous synthesized image cannot be reused
+    app.synthesis_cache_valid = false;
 }
 
 void onMouseButton(GLFWwindow* window, int button, int action, int mods)
@@ -703,6 +2090,66 @@ void onKeyboardInput(GLFWwindow* window, int key, int scancode, int action, int
             case GLFW_KEY_S:
                 app.synthesized_position[2] += 0.02;
                 break;
+            case GLFW_KEY_I:
+                app.incremental_synthesis = !app.incremental_synthesis;
+                printf("Incremental synthesis: %s\n", app.incremental_synthesis ? "on" : "off");
+                new_view = false;
+                break;
+            case GLFW_KEY_V:
+                app.foveated_synthesis = !app.foveated_synthesis;
+                app.synthesis_cache_valid = false;
+                printf("Foveated synthesis: %s\n", app.foveated_synthesis ? "on" : "off");
+                break;
+            case GLFW_KEY_T:
+                app.single_pass_stereo = !app.single_pass_stereo;
+                app.synthesis_cache_valid = false;
+                printf("Single pass stereo: %s\n", app.single_pass_stereo ? "on" : "off");
+                break;
+            case GLFW_KEY_K:
+                app.gpu_timer.enabled = !app.gpu_timer.enabled;
+                printf("GPU stage timing: %s\n", app.gpu_timer.enabled ? "on" : "off");
+                break;
+            case GLFW_KEY_M:
+                app.multi_draw_indirect = !app.multi_draw_indirect;
+                app.synthesis_cache_valid = false;
+                printf("Multi-draw-indirect synthesis: %s\n", app.multi_draw_indirect ? "on" : "off");
+                break;
+            case GLFW_KEY_C:
+                app.compute_splatting = !app.compute_splatting;
+                app.synthesis_cache_valid = false;
+                printf("Compute shader splatting: %s\n", app.compute_splatting ? "on" : "off");
+                break;
+            case GLFW_KEY_H:
+                app.hole_fill = (HoleFill)((app.hole_fill + 1) % 3);
+                app.synthesis_cache_valid = false;
+                printf("Hole filling: %s\n", app.hole_fill == HoleFill::HOLE_FILL_GPU ? "GPU" :
+                                             (app.hole_fill == HoleFill::HOLE_FILL_CPU ? "CPU" : "off"));
+                break;
+            case GLFW_KEY_G:
+                app.pull_push_fill = !app.pull_push_fill;
+                app.synthesis_cache_valid = false;
+                printf("Pull-push gap filling: %s\n", app.pull_push_fill ? "on" : "off");
+                break;
+            case GLFW_KEY_Z:
+                app.hiz_culling = !app.hiz_culling;
+                app.synthesis_cache_valid = false;
+                printf("Hierarchical-Z culling: %s\n", app.hiz_culling ? "on" : "off");
+                break;
+            case GLFW_KEY_O:
+                app.occlusion_budget = !app.occlusion_budget;
+                app.synthesis_cache_valid = false;
+                printf("Occlusion budget: %s\n", app.occlusion_budget ? "on" : "off");
+                break;
+            case GLFW_KEY_B:
+                app.depth_of_field = !app.depth_of_field;
+                printf("Depth of field: %s\n", app.depth_of_field ? "on" : "off");
+                new_view = false;
+                break;
+            case GLFW_KEY_P:
+                app.viewport_synthesis = !app.viewport_synthesis;
+                app.synthesis_cache_valid = false;
+                printf("Direct viewport synthesis: %s\n", app.viewport_synthesis ? "on" : "off");
+                break;
             default:
                 new_view = false;
                 break;
@@ -714,33 +2161,288 @@ void onKeyboardInput(GLFWwindow* window, int key, int scancode, int action, int
     }
 }
 
-void initializeOdsTextures(const char *file_prefix, float *camera_position)
+int initializeOdsTextures(const SceneManifest& scene, int image)
 {
-    // Read in color and depth images
-    int wc, hc, wd, hd;
-    float near, far;
-    int channels = 4;
+    CpuTraceZone zone("initializeOdsTextures");
+    int num_threads = std::max((int)std::thread::hardware_concurrency(), 1);
+
+    // Upload texture-ready view from cache (decoded and added to cache on first load)
+    OdsArchive entry;
+    uint8_t *color = NULL;
+    float *depth = NULL;
+    int width, height;
+    if (!app.view_cache_dir.empty() &&
+        vcOpenView(app.view_cache_dir.c_str(), app.view_cache_compress, scene, image, num_threads, &entry, &color,
+                   &depth, &width, &height))
+    {
+        if (color != NULL)
+        {
+            // Cache is not writable - use view it decoded, and stop trying to cache remaining views
+            app.view_cache_dir.clear();
+        }
+        else
+        {
+            const uint8_t *view_color;
+            const float *view_depth;
+            std::vector<uint8_t> scratch;
+            int success = oaReadView(&entry, 0, num_threads, &view_color, &view_depth, &scratch);
+            if (success)
+            {
+                std::vector<float> tile_min_depth;
+                computeTileMinDepths(view_depth, entry.views[0].width, entry.views[0].height, tile_min_depth);
+                createOdsViewTextures(view_color, view_depth, entry.views[0].width, entry.views[0].height,
+                                      scene.images[image].position, tile_min_depth);
+            }
+            oaCloseArchive(&entry);
+            if (success)
+            {
+                return 1;
+            }
+        }
+    }
+
+    // Read in color and depth images (unless cache already decoded them)
+    if (color == NULL && !scnReadImage(scene, image, num_threads, &color, &depth, &width, &height))
+    {
+        return 0;
+    }
+    std::vector<float> tile_min_depth;
+    computeTileMinDepths(depth, width, height, tile_min_depth);
+    createOdsViewTextures(color, depth, width, height, scene.images[image].position, tile_min_depth);
+
+    // Free memory (both depth encodings are malloc'd)
+    iioFreeImage(color);
+    free(depth);
+    return 1;
+}
+
+// Uploads packed views from memory mapped archive (no per-view file opens - raw views need no decode either)
+int initializeOdsArchive(const char *filename, int num_images, bool stream_tiles)
+{
+    CpuTraceZone zone("initializeOdsArchive");
+
+    OdsArchive archive;
+    if (!oaOpenArchive(filename, &archive))
+    {
+        return 0;
+    }
+    if ((int)archive.views.size() != num_images)
+    {
+        fprintf(stderr, "Error: %s holds %zu views, but scene lists %d images\n", filename, archive.views.size(),
+                num_images);
+        oaCloseArchive(&archive);
+        return 0;
+    }
+    if (stream_tiles)
+    {
+        if (initializeOdsStreaming(archive))
+        {
+            return 1;
+        }
+        fprintf(stderr, "Warning: %s cannot be streamed (needs C-DEP views packed with --compress) - loading all "
+                "tiles\n", filename);
+    }
+
+    std::vector<uint8_t> scratch;
+    int num_threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    for (size_t i = 0; i < archive.views.size(); i++)
+    {
+        const uint8_t *color;
+        const float *depth;
+        if (!oaReadView(&archive, i, num_threads, &color, &depth, &scratch))
+        {
+            fprintf(stderr, "Error: could not read view %zu of %s\n", i, filename);
+            oaCloseArchive(&archive);
+            return 0;
+        }
+        std::vector<float> tile_min_depth;
+        computeTileMinDepths(depth, archive.views[i].width, archive.views[i].height, tile_min_depth);
+        createOdsViewTextures(color, depth, archive.views[i].width, archive.views[i].height, archive.views[i].position,
+                              tile_min_depth);
+    }
+    oaCloseArchive(&archive);
+    return 1;
+}
+
+// Creates empty view textures that streamOdsTiles fills - archive stays mapped, and tile depth ranges stand in for
+// per-pixel depths when bounding parallax
+int initializeOdsStreaming(OdsArchive& archive)
+{
+    size_t i;
+    int t;
+    TlzHeader color_header, depth_header;
+    std::vector<TlzHeader> depth_headers(archive.views.size());
+    for (i = 0; i < archive.views.size(); i++)
+    {
+        const OdsArchiveView& view = archive.views[i];
+        if (app.ods_format != OdsFormat::CDEP || view.color_encoding != OA_ENCODING_TLZ ||
+            view.depth_encoding != OA_ENCODING_TLZ)
+        {
+            return 0;
+        }
+        tcReadHeader(archive.data + view.color_offset, view.color_size, &color_header);
+        tcReadHeader(archive.data + view.depth_offset, view.depth_size, &depth_header);
+
+        // Every point tile must lie within a single stream tile (so it can be skipped until that tile is loaded)
+        if (color_header.tile_size != depth_header.tile_size || depth_header.tile_size % ODS_TILE_SIZE != 0 ||
+            view.width != archive.views[0].width || view.height != archive.views[0].height ||
+            (i > 0 && depth_header.tile_size != depth_headers[0].tile_size))
+        {
+            return 0;
+        }
+        depth_headers[i] = depth_header;
+    }
+
+    // Stream tile and point tile layouts are the same for all views
+    const TlzHeader& header = depth_headers[0];
+    app.ods_width = header.width;
+    app.ods_height = header.height;
+    int num_stream_tiles = header.tiles_x * header.tiles_y;
+    app.stream_tile_bounds.resize(num_stream_tiles);
+    for (t = 0; t < num_stream_tiles; t++)
+    {
+        OdsStreamTile& tile = app.stream_tile_bounds[t];
+        tcGetTileRect(header, t, &tile.x, &tile.y, &tile.width, &tile.height);
+        computeTileBounds(tile.x, tile.y, tile.x + tile.width, tile.y + tile.height, tile.direction, tile.radius);
+    }
+    int tiles_x = (header.width + ODS_TILE_SIZE - 1) / ODS_TILE_SIZE;
+    int tiles_y = (header.height + ODS_TILE_SIZE - 1) / ODS_TILE_SIZE;
+    int tiles_per_stream_tile = header.tile_size / ODS_TILE_SIZE;
+    app.stream_tile_of_ods_tile.resize(tiles_x * tiles_y);
+    for (t = 0; t < tiles_x * tiles_y; t++)
+    {
+        app.stream_tile_of_ods_tile[t] = ((t / tiles_x) / tiles_per_stream_tile) * header.tiles_x +
+                                         (t % tiles_x) / tiles_per_stream_tile;
+    }
+
+    for (i = 0; i < archive.views.size(); i++)
+    {
+        const TlzTile *depth_tiles = tcGetTiles(archive.data + archive.views[i].depth_offset);
+        std::vector<float> tile_min_depth(tiles_x * tiles_y);
+        for (t = 0; t < tiles_x * tiles_y; t++)
+        {
+            tile_min_depth[t] = depth_tiles[app.stream_tile_of_ods_tile[t]].value_range[0];
+        }
+        createOdsViewTextures(NULL, NULL, archive.views[i].width, archive.views[i].height, archive.views[i].position,
+                              tile_min_depth);
+        app.stream_resident.push_back(std::vector<bool>(num_stream_tiles, false));
+    }
+    app.stream_archive = archive;
+    app.stream_tiles = true;
+    return 1;
+}
+
+// Decodes and uploads view's tiles that may project into view cone (a cone angle of pi loads the whole view)
+void streamOdsTiles(int view_index, glm::vec3& relative_cam_pos, glm::vec3& view_dir, float cone_angle)
+{
+    if (!app.stream_tiles)
+    {
+        return;
+    }
+    CpuTraceZone zone("streamOdsTiles");
+
+    const OdsArchiveView& view = app.stream_archive.views[view_index];
+    const uint8_t *color_tlz = app.stream_archive.data + view.color_offset;
+    const uint8_t *depth_tlz = app.stream_archive.data + view.depth_offset;
+    TlzHeader color_header, depth_header;
+    tcReadHeader(color_tlz, view.color_size, &color_header);
+    tcReadHeader(depth_tlz, view.depth_size, &depth_header);
+    const TlzTile *color_tiles = tcGetTiles(color_tlz);
+    const TlzTile *depth_tiles = tcGetTiles(depth_tlz);
+
+    size_t t;
+    double baseline = glm::length(relative_cam_pos);
+    std::vector<bool>& resident = app.stream_resident[view_index];
+
+    // Whole view (e.g. after leaving viewport synthesis) is decoded on all threads and uploaded at once
+    if (cone_angle >= M_PI)
+    {
+        if (std::find(resident.begin(), resident.end(), false) == resident.end())
+        {
+            return;
+        }
+        int num_threads = std::max((int)std::thread::hardware_concurrency(), 1);
+        std::vector<uint8_t> view_pixels((size_t)view.width * view.height * 4);
+        if (tcDecodeImage(color_tlz, view.color_size, num_threads, view_pixels.data()))
+        {
+            glBindTexture(GL_TEXTURE_2D, app.color_textures[view_index]);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, view.width, view.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                            view_pixels.data());
+        }
+        if (tcDecodeImage(depth_tlz, view.depth_size, num_threads, view_pixels.data()))
+        {
+            glBindTexture(GL_TEXTURE_2D, app.depth_textures[view_index]);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, view.width, view.height, GL_RED, GL_FLOAT, view_pixels.data());
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        for (t = 0; t < resident.size(); t++)
+        {
+            if (!resident[t])
+            {
+                app.stream_bytes += color_tiles[t].size + depth_tiles[t].size;
+            }
+        }
+        resident.assign(resident.size(), true);
+        return;
+    }
 
-    char filename_png[96];
-    snprintf(filename_png, 96, "%s.png", file_prefix);
-    uint8_t *color = iioReadImage(filename_png, &wc, &hc, &channels);
+    std::vector<uint8_t> pixels(depth_header.tile_size * depth_header.tile_size * 4);
+    for (t = 0; t < app.stream_tile_bounds.size(); t++)
+    {
+        OdsStreamTile& tile = app.stream_tile_bounds[t];
+        if (resident[t])
+        {
+            continue;
+        }
+        double margin = tileViewMargin(tile.radius, depth_tiles[t].value_range[0], baseline);
+        double angle = acos(std::max(-1.0f, std::min(glm::dot(tile.direction, view_dir), 1.0f)));
+        if (angle - margin >= cone_angle)
+        {
+            continue;
+        }
 
-    //char filename_rvl[96];
-    //snprintf(filename_rvl, 96, "%s.rvl", file_prefix);
-    //float *depth = iioReadRvlDepthImage(filename_rvl, &wd, &hd, &near, &far);
-    //if (wc != wd || hc != hd)
-    //{
-    //    fprintf(stderr, "Warning: width/height of color and depth images do not match\n");
-    //}
+        // Textures are views of texture array layers, so uploads land in shared storage
+        if (tcDecodeTile(color_tlz, color_header, t, pixels.data()))
+        {
+            glBindTexture(GL_TEXTURE_2D, app.color_textures[view_index]);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, tile.x, tile.y, tile.width, tile.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                            pixels.data());
+        }
+        if (tcDecodeTile(depth_tlz, depth_header, t, pixels.data()))
+        {
+            glBindTexture(GL_TEXTURE_2D, app.depth_textures[view_index]);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, tile.x, tile.y, tile.width, tile.height, GL_RED, GL_FLOAT,
+                            pixels.data());
+        }
+        resident[t] = true;
+        app.stream_bytes += color_tiles[t].size + depth_tiles[t].size;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
 
-    char filename_depth[96];
-    snprintf(filename_depth, 96, "%s.depth", file_prefix);
-    char *depth_buf;
-    iioReadFile(filename_depth, &depth_buf);
-    float *depth = reinterpret_cast<float*>(depth_buf);
+// Minimum depth of each tile (bounds parallax of tile's points for view-dependent culling)
+void computeTileMinDepths(const float *depth, int width, int height, std::vector<float>& tile_min_depth)
+{
+    int x, y;
+    int tiles_x = (width + ODS_TILE_SIZE - 1) / ODS_TILE_SIZE;
+    int tiles_y = (height + ODS_TILE_SIZE - 1) / ODS_TILE_SIZE;
+    tile_min_depth.assign(tiles_x * tiles_y, 9.9e12);
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++)
+        {
+            int tile = (y / ODS_TILE_SIZE) * tiles_x + (x / ODS_TILE_SIZE);
+            tile_min_depth[tile] = std::min(tile_min_depth[tile], depth[y * width + x]);
+        }
+    }
+}
 
-    app.ods_width = wc;
-    app.ods_height = hc;
+// Color and depth may be NULL (textures are then allocated and later filled by streamOdsTiles)
+void createOdsViewTextures(const uint8_t *color, const float *depth, int width, int height,
+                           const float *camera_position, std::vector<float>& tile_min_depth)
+{
+    app.ods_width = width;
+    app.ods_height = height;
 
     // Create color texture
     GLuint tex_color;
@@ -750,7 +2452,7 @@ void initializeOdsTextures(const char *file_prefix, float *camera_position)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, app.ods_width, app.ods_height, 0, GL_RGBA,
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, app.ods_width, app.ods_height, 0, GL_RGBA,
                  GL_UNSIGNED_BYTE, color);
 
     // Create depth texture
@@ -767,14 +2469,78 @@ void initializeOdsTextures(const char *file_prefix, float *camera_position)
     // Unbind textures
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    // Free memory
-    iioFreeImage(color);
-    //iioFreeRvlDepthImage(depth);
-    free(depth);
-
     app.color_textures.push_back(tex_color);
     app.depth_textures.push_back(tex_depth);
     app.camera_positions.push_back(glm::vec3(camera_position[0], camera_position[1], camera_position[2]));
+    app.tile_min_depths.push_back(tile_min_depth);
+}
+
+int initializeSceneManifest(const char *filename, double *near, double *far)
+{
+    SceneManifest scene;
+    if (!scnLoadManifest(filename, &scene))
+    {
+        return 0;
+    }
+
+    app.scene_name = scene.name;
+    app.ods_format = (scene.format == "dasp") ? OdsFormat::DASP : OdsFormat::CDEP;
+    app.ods_num_views = scene.num_views;
+    app.ods_max_views = (app.scene_max_views > 0) ? std::min(app.scene_max_views, scene.num_views) : scene.max_views;
+    app.dasp_ipd = scene.dasp_ipd;
+    app.dasp_focal_dist = scene.dasp_focal_dist;
+    app.scene_center = glm::vec3(scene.center[0], scene.center[1], scene.center[2]);
+    app.synthesized_position = app.scene_center;
+    *near = scene.near;
+    *far = scene.far;
+    if (!scene.archive.empty())
+    {
+        // Streaming only pays off when reprojecting directly into viewport (ODS image needs every tile of a view)
+        return initializeOdsArchive(scene.archive.c_str(), scene.images.size(),
+                                    scene.stream_tiles && app.viewport_synthesis);
+    }
+    for (size_t i = 0; i < scene.images.size(); i++)
+    {
+        if (!initializeOdsTextures(scene, i))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int measureOdsQuality(const char *truth_filename, QualityResult *result)
+{
+    int y;
+    int width, height;
+    int channels = 4;
+    uint8_t *truth = iioReadImage(truth_filename, &width, &height, &channels);
+    if (truth == NULL || width != app.ods_width || height != 2 * app.ods_height)
+    {
+        fprintf(stderr, "Error: %s is not a %dx%d ODS image\n", truth_filename, app.ods_width, 2 * app.ods_height);
+        if (truth != NULL)
+        {
+            iioFreeImage(truth);
+        }
+        return 0;
+    }
+
+    // Ground truth is stored top row first, render target bottom row first
+    size_t row_size = 4 * width;
+    std::vector<uint8_t> truth_rows(row_size * height);
+    for (y = 0; y < height; y++)
+    {
+        memcpy(truth_rows.data() + (height - 1 - y) * row_size, truth + y * row_size, row_size);
+    }
+    iioFreeImage(truth);
+
+    std::vector<uint8_t> pixels(row_size * height);
+    glBindTexture(GL_TEXTURE_2D, app.render_texture_color);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return qmComparePanoramas(pixels.data(), truth_rows.data(), app.ods_width, app.ods_height, 2, 4,
+                              std::max((int)std::thread::hardware_concurrency(), 1), result);
 }
 
 void initializeOdsRenderTargets()
@@ -786,7 +2552,7 @@ void initializeOdsRenderTargets()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, app.ods_width, 2 * app.ods_height, 0, GL_RGBA, 
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, app.ods_width, 2 * app.ods_height, 0, GL_RGBA, 
                  GL_UNSIGNED_BYTE, NULL);
 
     // Create depth render texture
@@ -799,13 +2565,92 @@ void initializeOdsRenderTargets()
     glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, app.ods_width, 2 * app.ods_height, 0, GL_RED, 
                  GL_FLOAT, NULL);
 
+    // Create color and depth history textures (copy of previous render, used for temporal reuse)
+    glGenTextures(1, &(app.history_texture_color));
+    glBindTexture(GL_TEXTURE_2D, app.history_texture_color);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, app.ods_width, 2 * app.ods_height, 0, GL_RGBA, 
+                 GL_UNSIGNED_BYTE, NULL);
+
+    glGenTextures(1, &(app.history_texture_depth));
+    glBindTexture(GL_TEXTURE_2D, app.history_texture_depth);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, app.ods_width, 2 * app.ods_height, 0, GL_RED, 
+                 GL_FLOAT, NULL);
+
+    // Create color and depth hole fill textures (output of hole filling pass)
+    glGenTextures(1, &(app.holefill_texture_color));
+    glBindTexture(GL_TEXTURE_2D, app.holefill_texture_color);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, app.ods_width, 2 * app.ods_height, 0, GL_RGBA, 
+                 GL_UNSIGNED_BYTE, NULL);
+
+    glGenTextures(1, &(app.holefill_texture_depth));
+    glBindTexture(GL_TEXTURE_2D, app.holefill_texture_depth);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, app.ods_width, 2 * app.ods_height, 0, GL_RED, 
+                 GL_FLOAT, NULL);
+
     // Unbind textures
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    // Create depth buffer object
+    // Create color and depth pull-push pyramids (mip level 0 is half resolution of render target)
+    glGenTextures(1, &(app.pullpush_texture_color));
+    glBindTexture(GL_TEXTURE_2D, app.pullpush_texture_color);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexStorage2D(GL_TEXTURE_2D, ODS_PULL_PUSH_LEVELS, GL_RGBA8, app.ods_width / 2, app.ods_height);
+
+    glGenTextures(1, &(app.pullpush_texture_depth));
+    glBindTexture(GL_TEXTURE_2D, app.pullpush_texture_depth);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexStorage2D(GL_TEXTURE_2D, ODS_PULL_PUSH_LEVELS, GL_R32F, app.ods_width / 2, app.ods_height);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Create hierarchical-Z texture (full mip chain of max depths)
+    app.hiz_levels = 1;
+    while ((std::max(app.ods_width, 2 * app.ods_height) >> app.hiz_levels) > 0)
+    {
+        app.hiz_levels++;
+    }
+    glGenTextures(1, &(app.hiz_texture));
+    glBindTexture(GL_TEXTURE_2D, app.hiz_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexStorage2D(GL_TEXTURE_2D, app.hiz_levels, GL_R32F, app.ods_width, 2 * app.ods_height);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Create RGB-D buffer (packed color and depth of both eyes, used by compute splatting)
+    glGenBuffers(1, &(app.splat_buffer));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, app.splat_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, 2 * app.ods_width * app.ods_height * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Create depth/stencil buffer object
     glGenRenderbuffers(1, &(app.render_depth_buffer));
     glBindRenderbuffer(GL_RENDERBUFFER, app.render_depth_buffer);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, app.ods_width, 2 * app.ods_height);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, app.ods_width, 2 * app.ods_height);
 
     // Unbind depth buffer object
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
@@ -817,11 +2662,20 @@ void initializeOdsRenderTargets()
                            app.render_texture_color, 0);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D,
                            app.render_texture_depth, 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
                               app.render_depth_buffer);
     GLenum draw_buffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
     glDrawBuffers(2, draw_buffers);
 
+    // Create hierarchical-Z framebuffer object (depth output only, shares depth/stencil buffer)
+    glGenFramebuffers(1, &(app.hiz_framebuffer));
+    glBindFramebuffer(GL_FRAMEBUFFER, app.hiz_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, app.hiz_texture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                              app.render_depth_buffer);
+    GLenum hiz_draw_buffers[2] = {GL_NONE, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, hiz_draw_buffers);
+
     // Unbind framebuffer object
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -848,6 +2702,106 @@ uint32_t mortonZIndex(uint16_t x, uint16_t y)
     return morton_idx;
 }
 
+void createOdsTextureArrays()
+{
+    int i;
+    int num_textures = app.color_textures.size();
+
+    // Create color texture array (one layer per ODS image)
+    glGenTextures(1, &(app.color_texture_array));
+    glBindTexture(GL_TEXTURE_2D_ARRAY, app.color_texture_array);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, app.ods_width, app.ods_height, num_textures);
+
+    // Create depth texture array (one layer per ODS image)
+    glGenTextures(1, &(app.depth_texture_array));
+    glBindTexture(GL_TEXTURE_2D_ARRAY, app.depth_texture_array);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_R32F, app.ods_width, app.ods_height, num_textures);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Copy each image into its layer, then replace 2D texture with a view of that layer (no duplicate storage)
+    for (i = 0; i < num_textures; i++)
+    {
+        glCopyImageSubData(app.color_textures[i], GL_TEXTURE_2D, 0, 0, 0, 0,
+                           app.color_texture_array, GL_TEXTURE_2D_ARRAY, 0, 0, 0, i,
+                           app.ods_width, app.ods_height, 1);
+        glCopyImageSubData(app.depth_textures[i], GL_TEXTURE_2D, 0, 0, 0, 0,
+                           app.depth_texture_array, GL_TEXTURE_2D_ARRAY, 0, 0, 0, i,
+                           app.ods_width, app.ods_height, 1);
+        glDeleteTextures(1, &(app.color_textures[i]));
+        glDeleteTextures(1, &(app.depth_textures[i]));
+        app.color_textures[i] = createTextureLayerView(app.color_texture_array, GL_RGBA8, i);
+        app.depth_textures[i] = createTextureLayerView(app.depth_texture_array, GL_R32F, i);
+    }
+}
+
+GLuint createTextureLayerView(GLuint texture_array, GLenum internal_format, int layer)
+{
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glTextureView(texture, GL_TEXTURE_2D, texture_array, internal_format, 0, 1, layer, 1);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+void initializeIndirectDrawBuffers()
+{
+    int i;
+    int num_textures = app.color_textures.size();
+
+    // Create buffer to store draw ids (instanced attribute, selected by each command's base instance)
+    GLuint *draw_ids = new GLuint[num_textures];
+    for (i = 0; i < num_textures; i++)
+    {
+        draw_ids[i] = i;
+    }
+    glBindVertexArray(app.ods_vertex_array);
+    GLuint vertex_draw_id_buffer;
+    glGenBuffers(1, &vertex_draw_id_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertex_draw_id_buffer);
+    glBufferData(GL_ARRAY_BUFFER, num_textures * sizeof(GLuint), draw_ids, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(app.vertex_draw_id_attrib);
+    glVertexAttribIPointer(app.vertex_draw_id_attrib, 1, GL_UNSIGNED_INT, 0, 0);
+    glVertexAttribDivisor(app.vertex_draw_id_attrib, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Create buffer to store per-view parameters
+    glGenBuffers(1, &(app.view_params_buffer));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, app.view_params_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, num_textures * sizeof(OdsViewParams), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Create buffer to store draw commands
+    glGenBuffers(1, &(app.draw_indirect_buffer));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, app.draw_indirect_buffer);
+    app.draw_indirect_capacity = num_textures * sizeof(DrawArraysIndirectCommand);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, app.draw_indirect_capacity, NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    // Create buffer to store per-frame constants
+    glGenBuffers(1, &(app.frame_params_buffer));
+    glBindBuffer(GL_UNIFORM_BUFFER, app.frame_params_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(OdsFrameParams), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Free memory
+    delete[] draw_ids;
+}
+
 void blockShuffle(GLfloat* vertices, GLfloat* texcoords, uint32_t size, uint32_t block_size)
 {
     int i, b;
@@ -898,36 +2852,58 @@ void createOdsPointData()
     // std::mt19937 g(rd());
     // std::iota(block_order, block_order + (blocks_x * blocks_y), 0);
     // std::shuffle(block_order, block_order + (blocks_x * blocks_y), g);
+
+    // Points are grouped in tiles (ODS_TILE_SIZE x ODS_TILE_SIZE), ordered coarse to fine within each tile:
+    // every 4th point (1/16 density), then remaining every 2nd point (1/4 density), then all remaining points
     GLfloat *vertices = new GLfloat[2 * size];
     GLfloat *texcoords = new GLfloat[2 * size];
-    for (j = 0; j < app.ods_height; j++)
-    //for (j = 0; j < app.ods_height * 2; j++)
+    int tx, ty, level;
+    int tiles_x = (app.ods_width + ODS_TILE_SIZE - 1) / ODS_TILE_SIZE;
+    int tiles_y = (app.ods_height + ODS_TILE_SIZE - 1) / ODS_TILE_SIZE;
+    uint32_t idx = 0;
+    app.ods_tiles.clear();
+    for (ty = 0; ty < tiles_y; ty++)
     {
-        for (i = 0; i < app.ods_width; i++)
-        //for (i = 0; i < app.ods_width * 2; i++)
+        for (tx = 0; tx < tiles_x; tx++)
         {
-            // uint16_t bx = i % block_size;
-            // uint16_t by = j % block_size;
-            // uint32_t bidx = mortonZIndex(bx, by);
-            // uint32_t block = blocks_x * (j / block_size) + (i / block_size);
-            // uint32_t idx = (block_size * block_size) * block + bidx;
-            //uint32_t idx = (block_size * block_size) * block_order[block] + bidx;
-
-            //uint32_t idx = mortonZIndex(i, j);
-            uint32_t idx = j * app.ods_width + i;
-            //uint32_t idx = j * app.ods_width * 2 + i;
-            
-            double norm_x = (i + 0.5) / (double)app.ods_width;
-            double norm_y = (j + 0.5) / (double)app.ods_height;
-            //double norm_x = (i + 0.5) / (double)(app.ods_width * 2);
-            //double norm_y = (j + 0.5) / (double)(app.ods_height * 2);
-
-            double azimuth = 2.0 * M_PI * (1.0 - norm_x);
-            double inclination = M_PI * norm_y;
-            vertices[2 * idx + 0] = azimuth;
-            vertices[2 * idx + 1] = inclination;
-            texcoords[2 * idx + 0] = norm_x;
-            texcoords[2 * idx + 1] = norm_y;
+            uint32_t x0 = tx * ODS_TILE_SIZE;
+            uint32_t y0 = ty * ODS_TILE_SIZE;
+            uint32_t x1 = std::min(x0 + ODS_TILE_SIZE, (uint32_t)app.ods_width);
+            uint32_t y1 = std::min(y0 + ODS_TILE_SIZE, (uint32_t)app.ods_height);
+
+            OdsTile tile;
+            tile.first = idx;
+            for (level = 2; level >= 0; level--)
+            {
+                for (j = y0; j < y1; j++)
+                {
+                    for (i = x0; i < x1; i++)
+                    {
+                        int stride = 1 << level;
+                        bool in_level = ((i - x0) % stride == 0) && ((j - y0) % stride == 0) &&
+                                        (level == 2 || ((i - x0) % (2 * stride) != 0) || ((j - y0) % (2 * stride) != 0));
+                        if (!in_level)
+                        {
+                            continue;
+                        }
+
+                        double norm_x = (i + 0.5) / (double)app.ods_width;
+                        double norm_y = (j + 0.5) / (double)app.ods_height;
+
+                        double azimuth = 2.0 * M_PI * (1.0 - norm_x);
+                        double inclination = M_PI * norm_y;
+                        vertices[2 * idx + 0] = azimuth;
+                        vertices[2 * idx + 1] = inclination;
+                        texcoords[2 * idx + 0] = norm_x;
+                        texcoords[2 * idx + 1] = norm_y;
+                        idx++;
+                    }
+                }
+                tile.count[level] = idx - tile.first;
+            }
+
+            computeTileBounds(x0, y0, x1, y1, tile.direction, tile.radius);
+            app.ods_tiles.push_back(tile);
         }
     }
     //blockShuffle(vertices, texcoords, size, 128);
@@ -1207,6 +3183,8 @@ void createSphere(int stacks, int slices)
 
 void determineViews(glm::vec3& camera_position, int num_views, std::vector<int>& view_indices)
 {
+    CpuTraceZone zone("determineViews");
+
     // Start by adding bounding corners (in num_views >= 2)
     if (num_views >= 2)
     {
@@ -1305,19 +3283,86 @@ void determineViews(glm::vec3& camera_position, int num_views, std::vector<int>&
     }
     */
 
-    // Sort based on distance
-    for (i = 0; i < view_indices.size() - 1; i++)
+    // Sort near to far (ties broken by view index so draw order and depth hints are deterministic)
+    std::sort(view_indices.begin(), view_indices.end(), [&camera_position](int a, int b) {
+        float d_a = glm::distance2(camera_position, app.camera_positions[a]);
+        float d_b = glm::distance2(camera_position, app.camera_positions[b]);
+        return (d_a < d_b) || (d_a == d_b && a < b);
+    });
+}
+
+#ifdef CDEP_BENCH
+int runBenchmark(BenchOptions& options)
+{
+    int i, f;
+
+    std::vector<CameraPathFrame> path;
+    if (!scnLoadCameraPath(options.camera_path.c_str(), &path))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Render as fast as possible and skip writing images
+    glfwSwapInterval(0);
+    app.save_synthesized_views = false;
+
+    BenchResult result;
+    result.scene = options.scene;
+    result.camera_path = options.camera_path;
+    result.warmup_iterations = options.warmup_iterations;
+    result.iterations = options.iterations;
+    result.path_frames = path.size();
+    result.ods_width = app.ods_width;
+    result.ods_height = app.ods_height;
+    result.num_views = std::min(app.ods_num_views, app.ods_max_views);
+
+    // Each frame fully re-synthesizes (no reuse of previous image) and waits for GPU to finish
+    double measure_start = glfwGetTime();
+    double quality_s = 0.0;
+    for (i = 0; i < options.warmup_iterations + options.iterations; i++)
     {
-        for (j = 0; j < view_indices.size() - 1 - i; j++)
+        if (i == options.warmup_iterations)
+        {
+            measure_start = glfwGetTime();
+            quality_s = 0.0;
+        }
+        for (f = 0; f < path.size(); f++)
         {
-            float d1 = glm::distance2(camera_position, app.camera_positions[view_indices[j]]);
-            float d2 = glm::distance2(camera_position, app.camera_positions[view_indices[j + 1]]);
-            if (d2 < d1)
+            app.synthesized_position = glm::vec3(path[f].position[0], path[f].position[1], path[f].position[2]);
+            app.camera_yaw = path[f].yaw;
+            app.camera_pitch = path[f].pitch;
+            app.modelview = glm::rotate(glm::mat4(1.0), (float)app.camera_pitch, glm::vec3(1.0, 0.0, 0.0));
+            app.modelview = glm::rotate(app.modelview, (float)app.camera_yaw, glm::vec3(0.0, 1.0, 0.0));
+            app.synthesis_cache_valid = false;
+
+            double frame_start = glfwGetTime();
+            synthesizeOdsImage(app.synthesized_position);
+            render();
+            glFinish();
+            double frame_ms = 1000.0 * (glfwGetTime() - frame_start);
+            if (i >= options.warmup_iterations)
+            {
+                result.frame_ms.push_back(frame_ms);
+            }
+
+            // Quality against ground truth (once per path frame, not included in measured time)
+            QualityResult quality;
+            double quality_start = glfwGetTime();
+            if (i == options.warmup_iterations && !path[f].truth_image.empty() &&
+                measureOdsQuality(path[f].truth_image.c_str(), &quality))
             {
-                int tmp_idx = view_indices[i];
-                view_indices[i] = view_indices[j];
-                view_indices[j] = tmp_idx;
+                result.psnr.push_back(quality.psnr);
+                result.ws_psnr.push_back(quality.ws_psnr);
             }
+            quality_s += glfwGetTime() - quality_start;
+
+            gtEndFrame(&app.gpu_timer);
+            glfwPollEvents();
         }
     }
+    result.total_s = glfwGetTime() - measure_start - quality_s;
+
+    bmPrintReport(result);
+    return bmWriteReport(options.report.c_str(), result) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
+#endif
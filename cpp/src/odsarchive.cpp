@@ -0,0 +1,283 @@
+#include "odsarchive.h"
+
+// Memory maps whole archive and validates view table (payloads are only paged in when read)
+int oaOpenArchive(const char *filename, OdsArchive *archive)
+{
+    archive->data = NULL;
+    archive->size = 0;
+    archive->views.clear();
+#ifdef _WIN32
+    archive->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (archive->file == INVALID_HANDLE_VALUE)
+    {
+        fprintf(stderr, "Error: could not open %s\n", filename);
+        return 0;
+    }
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(archive->file, &file_size);
+    archive->size = file_size.QuadPart;
+    archive->mapping = CreateFileMappingA(archive->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (archive->mapping != NULL)
+    {
+        archive->data = (const uint8_t*)MapViewOfFile(archive->mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+#else
+    archive->file = open(filename, O_RDONLY);
+    if (archive->file < 0)
+    {
+        fprintf(stderr, "Error: could not open %s\n", filename);
+        return 0;
+    }
+    struct stat file_stat;
+    fstat(archive->file, &file_stat);
+    archive->size = file_stat.st_size;
+    void *data = mmap(NULL, archive->size, PROT_READ, MAP_PRIVATE, archive->file, 0);
+    archive->data = (data != MAP_FAILED) ? (const uint8_t*)data : NULL;
+#endif
+    if (archive->data == NULL)
+    {
+        fprintf(stderr, "Error: could not memory map %s\n", filename);
+        oaCloseArchive(archive);
+        return 0;
+    }
+
+    OdsArchiveHeader header;
+    if (archive->size < sizeof(OdsArchiveHeader))
+    {
+        fprintf(stderr, "Error: %s is not a C-DEP archive\n", filename);
+        oaCloseArchive(archive);
+        return 0;
+    }
+    memcpy(&header, archive->data, sizeof(OdsArchiveHeader));
+    if (memcmp(header.magic, ODS_ARCHIVE_MAGIC, sizeof(ODS_ARCHIVE_MAGIC)) != 0 ||
+        header.version != ODS_ARCHIVE_VERSION)
+    {
+        fprintf(stderr, "Error: %s is not a version %d C-DEP archive\n", filename, ODS_ARCHIVE_VERSION);
+        oaCloseArchive(archive);
+        return 0;
+    }
+    uint64_t table_end = sizeof(OdsArchiveHeader) + (uint64_t)header.num_views * sizeof(OdsArchiveView);
+    if (header.num_views == 0)
+    {
+        fprintf(stderr, "Error: %s has no views\n", filename);
+        oaCloseArchive(archive);
+        return 0;
+    }
+    if (table_end > archive->size)
+    {
+        fprintf(stderr, "Error: view table of %s is truncated\n", filename);
+        oaCloseArchive(archive);
+        return 0;
+    }
+    archive->views.resize(header.num_views);
+    memcpy(archive->views.data(), archive->data + sizeof(OdsArchiveHeader), header.num_views * sizeof(OdsArchiveView));
+
+    uint32_t i;
+    for (i = 0; i < header.num_views; i++)
+    {
+        const OdsArchiveView& view = archive->views[i];
+        if (!oaValidPayload(archive, view.color_offset, view.color_size, view.color_encoding, view,
+                            TlzFormat::TLZ_FORMAT_RGBA8) ||
+            !oaValidPayload(archive, view.depth_offset, view.depth_size, view.depth_encoding, view,
+                            TlzFormat::TLZ_FORMAT_R32F))
+        {
+            fprintf(stderr, "Error: view %u of %s is corrupt or uses an unsupported encoding\n", i, filename);
+            oaCloseArchive(archive);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void oaCloseArchive(OdsArchive *archive)
+{
+#ifdef _WIN32
+    if (archive->data != NULL)
+    {
+        UnmapViewOfFile(archive->data);
+    }
+    if (archive->mapping != NULL)
+    {
+        CloseHandle(archive->mapping);
+    }
+    if (archive->file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(archive->file);
+    }
+    archive->mapping = NULL;
+    archive->file = INVALID_HANDLE_VALUE;
+#else
+    if (archive->data != NULL)
+    {
+        munmap((void*)archive->data, archive->size);
+    }
+    if (archive->file >= 0)
+    {
+        close(archive->file);
+    }
+    archive->file = -1;
+#endif
+    archive->data = NULL;
+    archive->size = 0;
+    archive->views.clear();
+}
+
+// Raw payloads are returned as pointers into mapping (valid until archive is closed). TLZ payloads are decoded into
+// `scratch` (valid until its next use)
+int oaReadView(const OdsArchive *archive, int view, int num_threads, const uint8_t **color, const float **depth,
+               std::vector<uint8_t> *scratch)
+{
+    const OdsArchiveView& info = archive->views[view];
+    size_t color_size = (size_t)info.width * info.height * 4;
+    if (info.color_encoding == OA_ENCODING_TLZ || info.depth_encoding == OA_ENCODING_TLZ)
+    {
+        scratch->resize(color_size + (size_t)info.width * info.height * sizeof(float));
+    }
+
+    *color = archive->data + info.color_offset;
+    if (info.color_encoding == OA_ENCODING_TLZ)
+    {
+        if (!tcDecodeImage(*color, info.color_size, num_threads, scratch->data()))
+        {
+            return 0;
+        }
+        *color = scratch->data();
+    }
+    // Payloads (and scratch after color) are 4 byte aligned, so casts are safe
+    *depth = reinterpret_cast<const float*>(archive->data + info.depth_offset);
+    if (info.depth_encoding == OA_ENCODING_TLZ)
+    {
+        if (!tcDecodeImage((const uint8_t*)*depth, info.depth_size, num_threads, scratch->data() + color_size))
+        {
+            return 0;
+        }
+        *depth = reinterpret_cast<const float*>(scratch->data() + color_size);
+    }
+    return 1;
+}
+
+// Reserves space for header and view table - payloads are streamed after it by oaAddView
+int oaBeginArchive(const char *filename, uint32_t num_views, OdsArchiveWriter *writer)
+{
+    writer->fp = fopen(filename, "wb");
+    if (writer->fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", filename);
+        return 0;
+    }
+    writer->num_views = num_views;
+    writer->views.clear();
+    writer->offset = sizeof(OdsArchiveHeader) + (uint64_t)num_views * sizeof(OdsArchiveView);
+    std::vector<uint8_t> table(writer->offset, 0);
+    if (fwrite(table.data(), 1, table.size(), writer->fp) != table.size())
+    {
+        fprintf(stderr, "Error: could not write %s\n", filename);
+        fclose(writer->fp);
+        return 0;
+    }
+    return 1;
+}
+
+// Compressed views are stored as TLZ tiles (faster to decode than PNG, but not uploadable straight from mapping)
+int oaAddView(OdsArchiveWriter *writer, const float *position, uint32_t width, uint32_t height, const uint8_t *color,
+              const float *depth, bool compress)
+{
+    if (writer->views.size() >= writer->num_views)
+    {
+        fprintf(stderr, "Error: archive was created for %u views\n", writer->num_views);
+        return 0;
+    }
+
+    OdsArchiveView view;
+    memset(&view, 0, sizeof(OdsArchiveView));
+    memcpy(view.position, position, 3 * sizeof(float));
+    view.width = width;
+    view.height = height;
+    view.color_encoding = compress ? OA_ENCODING_TLZ : OA_ENCODING_RAW;
+    view.depth_encoding = compress ? OA_ENCODING_TLZ : OA_ENCODING_RAW;
+    view.color_size = (uint64_t)width * height * 4;
+    view.depth_size = (uint64_t)width * height * sizeof(float);
+    std::vector<uint8_t> color_tlz, depth_tlz;
+    if (compress)
+    {
+        tcEncodeImage(color, width, height, TlzFormat::TLZ_FORMAT_RGBA8, TLZ_DEFAULT_TILE_SIZE, &color_tlz);
+        tcEncodeImage((const uint8_t*)depth, width, height, TlzFormat::TLZ_FORMAT_R32F, TLZ_DEFAULT_TILE_SIZE,
+                      &depth_tlz);
+        color = color_tlz.data();
+        depth = (const float*)depth_tlz.data();
+        view.color_size = color_tlz.size();
+        view.depth_size = depth_tlz.size();
+    }
+    if (!oaWritePayload(writer, color, view.color_size, &view.color_offset) ||
+        !oaWritePayload(writer, depth, view.depth_size, &view.depth_offset))
+    {
+        return 0;
+    }
+    writer->views.push_back(view);
+    return 1;
+}
+
+// Writes header and view table once all payloads are known
+int oaFinishArchive(OdsArchiveWriter *writer)
+{
+    int success = writer->views.size() == writer->num_views;
+    if (!success)
+    {
+        fprintf(stderr, "Error: archive has %zu of %u views\n", writer->views.size(), writer->num_views);
+    }
+    else
+    {
+        OdsArchiveHeader header;
+        memset(&header, 0, sizeof(OdsArchiveHeader));
+        memcpy(header.magic, ODS_ARCHIVE_MAGIC, sizeof(ODS_ARCHIVE_MAGIC));
+        header.version = ODS_ARCHIVE_VERSION;
+        header.num_views = writer->num_views;
+        header.alignment = ODS_ARCHIVE_ALIGNMENT;
+        success = fseek(writer->fp, 0, SEEK_SET) == 0 &&
+                  fwrite(&header, sizeof(OdsArchiveHeader), 1, writer->fp) == 1 &&
+                  fwrite(writer->views.data(), sizeof(OdsArchiveView), writer->num_views, writer->fp) == writer->num_views;
+        if (!success)
+        {
+            fprintf(stderr, "Error: could not write archive view table\n");
+        }
+    }
+    success = (fclose(writer->fp) == 0) && success;
+    writer->fp = NULL;
+    return success;
+}
+
+
+// Private
+static int oaValidPayload(const OdsArchive *archive, uint64_t offset, uint64_t size, uint32_t encoding,
+                          const OdsArchiveView& view, TlzFormat format)
+{
+    if (offset > archive->size || size > archive->size - offset)
+    {
+        return 0;
+    }
+    if (encoding == OA_ENCODING_RAW)
+    {
+        return size == (uint64_t)view.width * view.height * 4;
+    }
+    TlzHeader header;
+    return encoding == OA_ENCODING_TLZ && tcReadHeader(archive->data + offset, size, &header) &&
+           header.width == view.width && header.height == view.height && header.format == (uint32_t)format;
+}
+
+static int oaWritePayload(OdsArchiveWriter *writer, const void *data, uint64_t size, uint64_t *offset)
+{
+    // Pad to page boundary so mapped payloads can be handed to GL (or cast) without copies
+    // (padding is written rather than seeked over - 32-bit fseek offsets cannot address large archives)
+    static const uint8_t padding[ODS_ARCHIVE_ALIGNMENT] = {0};
+    uint64_t aligned = (writer->offset + ODS_ARCHIVE_ALIGNMENT - 1) & ~(uint64_t)(ODS_ARCHIVE_ALIGNMENT - 1);
+    size_t pad = aligned - writer->offset;
+    if (fwrite(padding, 1, pad, writer->fp) != pad || fwrite(data, 1, size, writer->fp) != size)
+    {
+        fprintf(stderr, "Error: could not write archive payload\n");
+        return 0;
+    }
+    *offset = aligned;
+    writer->offset = aligned + size;
+    return 1;
+}
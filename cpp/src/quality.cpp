@@ -0,0 +1,112 @@
+#include "quality.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Compares stacked equirectangular eye images (each width x height, rows in same order for test and truth).
+// Pixels that are black in test image are holes and are excluded, matching post_process/psnr.py
+int qmComparePanoramas(const uint8_t *test, const uint8_t *truth, int width, int height, int num_eyes, int channels,
+                       int num_threads, QualityResult *result)
+{
+    int t;
+    int num_rows = num_eyes * height;
+    num_threads = std::max(std::min(num_threads, num_rows), 1);
+
+    std::vector<std::thread> threads;
+    std::vector<QualitySums> sums(num_threads);
+    int rows_per_thread = (num_rows + num_threads - 1) / num_threads;
+    for (t = 0; t < num_threads; t++)
+    {
+        int row_start = std::min(t * rows_per_thread, num_rows);
+        int row_end = std::min(row_start + rows_per_thread, num_rows);
+        threads.push_back(std::thread(qmAccumulateRows, test, truth, width, height, channels, row_start, row_end,
+                                      &(sums[t])));
+    }
+
+    QualitySums total = {0, 0.0, 0, 0.0};
+    for (t = 0; t < num_threads; t++)
+    {
+        threads[t].join();
+        total.sq_err += sums[t].sq_err;
+        total.weighted_sq_err += sums[t].weighted_sq_err;
+        total.valid_pixels += sums[t].valid_pixels;
+        total.valid_weight += sums[t].valid_weight;
+    }
+
+    result->valid_pixels = total.valid_pixels;
+    if (total.valid_pixels == 0)
+    {
+        result->psnr = 0.0;
+        result->ws_psnr = 0.0;
+        return 0;
+    }
+    // Identical images would have infinite PSNR
+    double mse = total.sq_err / (3.0 * total.valid_pixels);
+    double ws_mse = total.weighted_sq_err / (3.0 * total.valid_weight);
+    result->psnr = (mse > 0.0) ? std::min(20.0 * log10(255.0 / sqrt(mse)), QM_MAX_PSNR) : QM_MAX_PSNR;
+    result->ws_psnr = (ws_mse > 0.0) ? std::min(20.0 * log10(255.0 / sqrt(ws_mse)), QM_MAX_PSNR) : QM_MAX_PSNR;
+    return 1;
+}
+
+
+// Private
+static void qmAccumulateRows(const uint8_t *test, const uint8_t *truth, int width, int height, int channels,
+                             int row_start, int row_end, QualitySums *sums)
+{
+    int y;
+    QualitySums local = {0, 0.0, 0, 0.0};
+    for (y = row_start; y < row_end; y++)
+    {
+        // Row sums are integers (exact), only scaled by row's weight once
+        uint64_t row_sq_err = 0;
+        uint64_t row_valid = 0;
+        const uint8_t *test_row = test + (size_t)y * width * channels;
+        const uint8_t *truth_row = truth + (size_t)y * width * channels;
+        if (channels == 4)
+        {
+            qmAccumulateRow<4>(test_row, truth_row, width, &row_sq_err, &row_valid);
+        }
+        else
+        {
+            qmAccumulateRow<3>(test_row, truth_row, width, &row_sq_err, &row_valid);
+        }
+        double weight = qmRowWeight(y % height, height, width);
+        local.sq_err += row_sq_err;
+        local.weighted_sq_err += weight * row_sq_err;
+        local.valid_pixels += row_valid;
+        local.valid_weight += weight * row_valid;
+    }
+    *sums = local;
+}
+
+// Fixed channel stride and no branch on holes (error is masked instead), so compiler can vectorize loop
+template <int CHANNELS>
+static void qmAccumulateRow(const uint8_t *test_row, const uint8_t *truth_row, int width, uint64_t *sq_err,
+                            uint64_t *valid)
+{
+    int x;
+    uint64_t row_sq_err = 0;
+    uint64_t row_valid = 0;
+    for (x = 0; x < width; x++)
+    {
+        const uint8_t *t = test_row + x * CHANNELS;
+        const uint8_t *g = truth_row + x * CHANNELS;
+        uint32_t non_black = (t[0] | t[1] | t[2]) != 0;
+        int err_r = (int)t[0] - (int)g[0];
+        int err_g = (int)t[1] - (int)g[1];
+        int err_b = (int)t[2] - (int)g[2];
+        row_sq_err += non_black * (uint32_t)(err_r * err_r + err_g * err_g + err_b * err_b);
+        row_valid += non_black;
+    }
+    *sq_err = row_sq_err;
+    *valid = row_valid;
+}
+
+// Fraction of unit sphere covered by one pixel of row (area between its parallels, 1 pixel of longitude)
+static double qmRowWeight(int row, int height, int width)
+{
+    double lat1 = M_PI * ((double)row / height) - 0.5 * M_PI;
+    double lat2 = M_PI * ((double)(row + 1) / height) - 0.5 * M_PI;
+    return (sin(lat2) - sin(lat1)) * (2.0 * M_PI / width) / (4.0 * M_PI);
+}
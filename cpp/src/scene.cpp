@@ -0,0 +1,181 @@
+#include "scene.h"
+
+// Reads scene manifest (image file prefixes are relative to working directory)
+int scnLoadManifest(const char *filename, SceneManifest *scene)
+{
+    JsonValue root;
+    if (!jsonParseFile(filename, &root))
+    {
+        return 0;
+    }
+
+    scene->name = jsonGetString(root, "name", filename);
+    scene->format = jsonGetString(root, "format", "cdep");
+    if (scene->format != "cdep" && scene->format != "dasp")
+    {
+        fprintf(stderr, "Error: unknown format '%s' in %s\n", scene->format.c_str(), filename);
+        return 0;
+    }
+    scene->dasp_ipd = jsonGetNumber(root, "dasp_ipd", 0.7);
+    scene->dasp_focal_dist = jsonGetNumber(root, "dasp_focal_dist", 1.95);
+    scene->near = jsonGetNumber(root, "near", 0.01);
+    scene->far = jsonGetNumber(root, "far", 30.0);
+    std::string color_encoding = jsonGetString(root, "color_encoding", "png");
+    if (color_encoding != "png" && color_encoding != "tlz")
+    {
+        fprintf(stderr, "Error: unknown color encoding '%s' in %s\n", color_encoding.c_str(), filename);
+        return 0;
+    }
+    scene->color_encoding = (color_encoding == "tlz") ? SceneColorEncoding::SCENE_COLOR_TLZ :
+                                                        SceneColorEncoding::SCENE_COLOR_PNG;
+    std::string depth_encoding = jsonGetString(root, "depth_encoding", "float");
+    if (depth_encoding != "float" && depth_encoding != "rvl")
+    {
+        fprintf(stderr, "Error: unknown depth encoding '%s' in %s\n", depth_encoding.c_str(), filename);
+        return 0;
+    }
+    scene->depth_encoding = (depth_encoding == "rvl") ? SceneDepthEncoding::SCENE_DEPTH_RVL :
+                                                        SceneDepthEncoding::SCENE_DEPTH_FLOAT;
+    scene->center[0] = 0.0;
+    scene->center[1] = 1.7;
+    scene->center[2] = 0.0;
+    jsonGetVec3(root, "center", scene->center);
+    scene->archive = jsonGetString(root, "archive", "");
+    scene->stream_tiles = jsonGetBool(root, "stream_tiles", false);
+
+    const JsonValue *images = jsonGetMember(root, "images");
+    if (images == NULL || images->type != JsonType::JSON_ARRAY || images->array.empty())
+    {
+        fprintf(stderr, "Error: %s does not list any images\n", filename);
+        return 0;
+    }
+    scene->images.clear();
+    for (size_t i = 0; i < images->array.size(); i++)
+    {
+        SceneImage image;
+        image.file_prefix = jsonGetString(images->array[i], "file_prefix", "");
+        if (image.file_prefix.empty() || !jsonGetVec3(images->array[i], "position", image.position))
+        {
+            fprintf(stderr, "Error: image %zu of %s needs 'file_prefix' and 'position'\n", i, filename);
+            return 0;
+        }
+        scene->images.push_back(image);
+    }
+
+    // DASP views are a left and right image pair
+    int available_views = (scene->format == "dasp") ? scene->images.size() / 2 : scene->images.size();
+    scene->num_views = jsonGetNumber(root, "num_views", available_views);
+    scene->max_views = jsonGetNumber(root, "max_views", scene->num_views);
+    if (scene->num_views < 1 || scene->num_views > available_views)
+    {
+        fprintf(stderr, "Error: %s uses %d views, but has images for %d\n", filename, scene->num_views,
+                available_views);
+        return 0;
+    }
+    return 1;
+}
+
+// Color (<prefix>.png or .tlz) and depth (<prefix>.depth or .rvl) files of image
+void scnGetImageFilenames(const SceneManifest& scene, int image, std::string *color_filename,
+                          std::string *depth_filename)
+{
+    const std::string& file_prefix = scene.images[image].file_prefix;
+    *color_filename = file_prefix + ((scene.color_encoding == SceneColorEncoding::SCENE_COLOR_TLZ) ? ".tlz" : ".png");
+    *depth_filename = file_prefix + ((scene.depth_encoding == SceneDepthEncoding::SCENE_DEPTH_RVL) ? ".rvl" : ".depth");
+}
+
+// Reads RGBA color and depth of image - both are malloc'd
+int scnReadImage(const SceneManifest& scene, int image, int num_threads, uint8_t **color, float **depth, int *width,
+                 int *height)
+{
+    int wc, hc, wd, hd;
+    float near, far;
+    std::string color_filename, depth_filename;
+    scnGetImageFilenames(scene, image, &color_filename, &depth_filename);
+
+    if (scene.color_encoding == SceneColorEncoding::SCENE_COLOR_TLZ)
+    {
+        // Tiles decode in parallel (no inflate or unfiltering)
+        TlzFormat format;
+        *color = tcReadImage(color_filename.c_str(), num_threads, &wc, &hc, &format);
+        if (*color != NULL && format != TlzFormat::TLZ_FORMAT_RGBA8)
+        {
+            fprintf(stderr, "Error: %s is not an RGBA image\n", color_filename.c_str());
+            free(*color);
+            *color = NULL;
+        }
+    }
+    else
+    {
+        int channels = 4;
+        *color = iioReadImage(color_filename.c_str(), &wc, &hc, &channels);
+    }
+    if (*color == NULL)
+    {
+        fprintf(stderr, "Error: could not read %s\n", color_filename.c_str());
+        return 0;
+    }
+
+    if (scene.depth_encoding == SceneDepthEncoding::SCENE_DEPTH_RVL)
+    {
+        *depth = iioReadRvlDepthImage(depth_filename.c_str(), &wd, &hd, &near, &far);
+    }
+    else
+    {
+        // Raw 32-bit float distances (same dimensions as color image)
+        char *depth_buf;
+        int depth_size = iioReadFile(depth_filename.c_str(), &depth_buf);
+        *depth = reinterpret_cast<float*>(depth_buf);
+        wd = (depth_size == (int)(wc * hc * sizeof(float))) ? wc : 0;
+        hd = hc;
+    }
+    if (*depth == NULL || wc != wd || hc != hd)
+    {
+        fprintf(stderr, "Error: %s is missing or does not match color image\n", depth_filename.c_str());
+        iioFreeImage(*color);
+        free(*depth);
+        return 0;
+    }
+    *width = wc;
+    *height = hc;
+    return 1;
+}
+
+// Reads camera path (frame positions are offsets from optional 'origin')
+int scnLoadCameraPath(const char *filename, std::vector<CameraPathFrame> *path)
+{
+    JsonValue root;
+    if (!jsonParseFile(filename, &root))
+    {
+        return 0;
+    }
+
+    float origin[3] = {0.0, 0.0, 0.0};
+    jsonGetVec3(root, "origin", origin);
+
+    const JsonValue *frames = jsonGetMember(root, "frames");
+    if (frames == NULL || frames->type != JsonType::JSON_ARRAY || frames->array.empty())
+    {
+        fprintf(stderr, "Error: %s does not list any frames\n", filename);
+        return 0;
+    }
+    path->clear();
+    for (size_t i = 0; i < frames->array.size(); i++)
+    {
+        CameraPathFrame frame;
+        if (!jsonGetVec3(frames->array[i], "position", frame.position))
+        {
+            fprintf(stderr, "Error: frame %zu of %s needs 'position'\n", i, filename);
+            return 0;
+        }
+        for (int j = 0; j < 3; j++)
+        {
+            frame.position[j] += origin[j];
+        }
+        frame.yaw = jsonGetNumber(frames->array[i], "yaw", 0.0);
+        frame.pitch = jsonGetNumber(frames->array[i], "pitch", 0.0);
+        frame.truth_image = jsonGetString(frames->array[i], "truth", "");
+        path->push_back(frame);
+    }
+    return 1;
+}
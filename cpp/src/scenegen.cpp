@@ -0,0 +1,389 @@
+#include "scenegen.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static SgVec3 sgVec3(float x, float y, float z)
+{
+    SgVec3 v = {x, y, z};
+    return v;
+}
+
+static float sgRandom(std::mt19937& rng, float min, float max)
+{
+    // mt19937 output is fully specified, so scenes are identical on every platform
+    return min + (max - min) * (rng() / 4294967296.0f);
+}
+
+// Ray traces C-DEP panoramas (equirectangular color and distance from camera) of a procedural scene at
+// `num_views` camera positions, then writes scene manifest (<name>.json) and camera path (<name>_path.json)
+int sgGenerateScene(const SceneGenOptions& options)
+{
+    int i, t;
+    int width = options.width;
+    int height = options.width / 2;
+    if (width < 2 || options.num_views < 1)
+    {
+        fprintf(stderr, "Error: scene needs width >= 2 and at least 1 view\n");
+        return 0;
+    }
+#ifdef _WIN32
+    _mkdir(options.output_dir.c_str());
+#else
+    mkdir(options.output_dir.c_str(), 0755);
+#endif
+
+    std::vector<SgPrimitive> primitives;
+    sgBuildScene(options, primitives);
+
+    // First two views bound the view volume (used as corners by view selection), remaining are random within it
+    std::mt19937 rng(options.seed);
+    std::vector<SgVec3> positions;
+    const float *c = options.center;
+    const float *e = options.view_extent;
+    for (i = 0; i < options.num_views; i++)
+    {
+        if (i < 2)
+        {
+            float s = (i == 0) ? -1.0f : 1.0f;
+            positions.push_back(sgVec3(c[0] + s * e[0], c[1] - s * e[1], c[2] + s * e[2]));
+        }
+        else
+        {
+            positions.push_back(sgVec3(sgRandom(rng, c[0] - e[0], c[0] + e[0]), sgRandom(rng, c[1] - e[1], c[1] + e[1]),
+                                       sgRandom(rng, c[2] - e[2], c[2] + e[2])));
+        }
+    }
+
+    uint8_t *color = new uint8_t[4 * (size_t)width * height];
+    float *depth = new float[(size_t)width * height];
+    int num_threads = std::max(options.num_threads, 1);
+    int rows_per_thread = (height + num_threads - 1) / num_threads;
+    for (i = 0; i < options.num_views; i++)
+    {
+        std::vector<std::thread> threads;
+        for (t = 0; t < num_threads; t++)
+        {
+            int row_start = t * rows_per_thread;
+            int row_end = std::min(row_start + rows_per_thread, height);
+            threads.push_back(std::thread(sgRenderRows, std::cref(primitives), positions[i], width, height,
+                                          row_start, row_end, color, depth));
+        }
+        for (t = 0; t < num_threads; t++)
+        {
+            threads[t].join();
+        }
+
+        char filename[512];
+        snprintf(filename, 512, "%s/%s_camera_%d.png", options.output_dir.c_str(), options.name.c_str(), i + 1);
+        if (!iioWriteImagePng(filename, width, height, 4, 0, color))
+        {
+            fprintf(stderr, "Error: could not write %s\n", filename);
+            delete[] color;
+            delete[] depth;
+            return 0;
+        }
+        snprintf(filename, 512, "%s/%s_camera_%d.depth", options.output_dir.c_str(), options.name.c_str(), i + 1);
+        FILE *fp = fopen(filename, "wb");
+        if (fp == NULL || fwrite(depth, sizeof(float), (size_t)width * height, fp) != (size_t)width * height)
+        {
+            fprintf(stderr, "Error: could not write %s\n", filename);
+            if (fp != NULL)
+            {
+                fclose(fp);
+            }
+            delete[] color;
+            delete[] depth;
+            return 0;
+        }
+        fclose(fp);
+        printf("Generated view %d/%d\n", i + 1, options.num_views);
+    }
+    delete[] color;
+    delete[] depth;
+
+    return sgWriteManifest(options, positions) && sgWriteCameraPath(options);
+}
+
+
+// Private
+static void sgBuildScene(const SceneGenOptions& options, std::vector<SgPrimitive>& primitives)
+{
+    int i;
+    const float *c = options.center;
+    SgPrimitive p;
+
+    if (options.type == SceneGenType::SCENEGEN_SPHERES)
+    {
+        // Ring of spheres around view volume, on checkered floor under sky
+        p.type = 4;
+        p.a = sgVec3(c[0], c[1], c[2]);
+        p.b = sgVec3(25.0f, 0.0f, 0.0f);
+        p.color = sgVec3(0.55f, 0.7f, 0.95f);
+        primitives.push_back(p);
+        p.type = 3;
+        p.color = sgVec3(0.75f, 0.75f, 0.7f);
+        primitives.push_back(p);
+        const SgVec3 colors[4] = {{0.9f, 0.25f, 0.2f}, {0.2f, 0.75f, 0.3f}, {0.25f, 0.35f, 0.9f}, {0.9f, 0.8f, 0.2f}};
+        for (i = 0; i < 8; i++)
+        {
+            float angle = i * M_PI / 4.0;
+            float ring = (i % 2 == 0) ? 2.0f : 3.5f;
+            float radius = (i % 2 == 0) ? 0.4f : 0.7f;
+            p.type = 0;
+            p.a = sgVec3(c[0] + ring * cos(angle), c[1] + 0.5f * sin(2.0f * angle), c[2] + ring * sin(angle));
+            p.b = sgVec3(radius, 0.0f, 0.0f);
+            p.color = colors[i % 4];
+            primitives.push_back(p);
+        }
+        return;
+    }
+
+    // Room (6m x 3m x 7m) centered horizontally on view volume
+    p.type = 2;
+    p.a = sgVec3(c[0] - 3.0f, 0.0f, c[2] - 3.5f);
+    p.b = sgVec3(c[0] + 3.0f, 3.0f, c[2] + 3.5f);
+    p.color = sgVec3(0.85f, 0.8f, 0.7f);
+    primitives.push_back(p);
+
+    if (options.type == SceneGenType::SCENEGEN_OCCLUDERS)
+    {
+        // Random boxes and spheres, kept clear of view volume so no camera is inside an occluder
+        std::mt19937 rng(options.seed + 1);
+        float clearance = sqrt(options.view_extent[0] * options.view_extent[0] +
+                               options.view_extent[1] * options.view_extent[1] +
+                               options.view_extent[2] * options.view_extent[2]) + 0.2f;
+        i = 0;
+        while (i < options.num_occluders)
+        {
+            float size = sgRandom(rng, 0.15f, 0.5f);
+            SgVec3 pos = sgVec3(sgRandom(rng, c[0] - 2.5f, c[0] + 2.5f), sgRandom(rng, 0.2f, 2.8f),
+                                sgRandom(rng, c[2] - 3.0f, c[2] + 3.0f));
+            float dx = pos.x - c[0];
+            float dy = pos.y - c[1];
+            float dz = pos.z - c[2];
+            bool is_box = (rng() & 1) != 0;
+            p.color = sgVec3(sgRandom(rng, 0.2f, 0.95f), sgRandom(rng, 0.2f, 0.95f), sgRandom(rng, 0.2f, 0.95f));
+            if (sqrt(dx * dx + dy * dy + dz * dz) < clearance + 1.75f * size)
+            {
+                continue;
+            }
+            if (is_box)
+            {
+                p.type = 1;
+                p.a = sgVec3(pos.x - size, pos.y - size, pos.z - size);
+                p.b = sgVec3(pos.x + size, pos.y + size, pos.z + size);
+            }
+            else
+            {
+                p.type = 0;
+                p.a = pos;
+                p.b = sgVec3(size, 0.0f, 0.0f);
+            }
+            primitives.push_back(p);
+            i++;
+        }
+    }
+}
+
+static void sgRenderRows(const std::vector<SgPrimitive>& primitives, SgVec3 origin, int width, int height,
+                         int row_start, int row_end, uint8_t *color, float *depth)
+{
+    int x, y;
+    for (y = row_start; y < row_end; y++)
+    {
+        // Same mapping as ODS point data: row -> inclination (0 at top), column -> azimuth (2*pi at left)
+        float inclination = M_PI * (y + 0.5) / height;
+        for (x = 0; x < width; x++)
+        {
+            float azimuth = 2.0 * M_PI * (1.0 - (x + 0.5) / width);
+            SgVec3 dir = sgVec3(sin(azimuth) * sin(inclination), cos(inclination), cos(azimuth) * sin(inclination));
+            SgVec3 rgb;
+            size_t idx = (size_t)y * width + x;
+            depth[idx] = sgTrace(primitives, origin, dir, &rgb);
+            color[4 * idx + 0] = (uint8_t)(255.0f * std::min(rgb.x, 1.0f));
+            color[4 * idx + 1] = (uint8_t)(255.0f * std::min(rgb.y, 1.0f));
+            color[4 * idx + 2] = (uint8_t)(255.0f * std::min(rgb.z, 1.0f));
+            color[4 * idx + 3] = 255;
+        }
+    }
+}
+
+// Returns distance to nearest surface along (unit) ray and its shaded color
+static float sgTrace(const std::vector<SgPrimitive>& primitives, SgVec3 origin, SgVec3 dir, SgVec3 *color)
+{
+    const float epsilon = 1.0e-4f;
+    float best_t = 1.0e30f;
+    int best = -1;
+    SgVec3 normal = sgVec3(0.0f, 1.0f, 0.0f);
+    for (size_t i = 0; i < primitives.size(); i++)
+    {
+        const SgPrimitive& p = primitives[i];
+        float t = -1.0f;
+        SgVec3 n = sgVec3(0.0f, 1.0f, 0.0f);
+        if (p.type == 0 || p.type == 4)
+        {
+            SgVec3 oc = sgVec3(origin.x - p.a.x, origin.y - p.a.y, origin.z - p.a.z);
+            float b = oc.x * dir.x + oc.y * dir.y + oc.z * dir.z;
+            float disc = b * b - (oc.x * oc.x + oc.y * oc.y + oc.z * oc.z - p.b.x * p.b.x);
+            if (disc >= 0.0f)
+            {
+                float root = sqrt(disc);
+                t = (-b - root > epsilon) ? -b - root : -b + root;
+                SgVec3 hit = sgVec3(origin.x + t * dir.x, origin.y + t * dir.y, origin.z + t * dir.z);
+                n = sgVec3((hit.x - p.a.x) / p.b.x, (hit.y - p.a.y) / p.b.x, (hit.z - p.a.z) / p.b.x);
+            }
+        }
+        else if (p.type == 1)
+        {
+            float o[3] = {origin.x, origin.y, origin.z};
+            float d[3] = {dir.x, dir.y, dir.z};
+            float lo[3] = {p.a.x, p.a.y, p.a.z};
+            float hi[3] = {p.b.x, p.b.y, p.b.z};
+            float t_near = -1.0e30f;
+            float t_far = 1.0e30f;
+            int axis = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                float inv = 1.0f / d[k];
+                float t0 = (lo[k] - o[k]) * inv;
+                float t1 = (hi[k] - o[k]) * inv;
+                if (t0 > t1)
+                {
+                    std::swap(t0, t1);
+                }
+                if (t0 > t_near)
+                {
+                    t_near = t0;
+                    axis = k;
+                }
+                t_far = std::min(t_far, t1);
+            }
+            if (t_near <= t_far && t_near > epsilon)
+            {
+                t = t_near;
+                float nk[3] = {0.0f, 0.0f, 0.0f};
+                nk[axis] = (d[axis] > 0.0f) ? -1.0f : 1.0f;
+                n = sgVec3(nk[0], nk[1], nk[2]);
+            }
+        }
+        else if (p.type == 2)
+        {
+            float o[3] = {origin.x, origin.y, origin.z};
+            float d[3] = {dir.x, dir.y, dir.z};
+            float lo[3] = {p.a.x, p.a.y, p.a.z};
+            float hi[3] = {p.b.x, p.b.y, p.b.z};
+            t = 1.0e30f;
+            int axis = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                float tk = (d[k] > 0.0f) ? (hi[k] - o[k]) / d[k] : ((d[k] < 0.0f) ? (lo[k] - o[k]) / d[k] : 1.0e30f);
+                if (tk < t)
+                {
+                    t = tk;
+                    axis = k;
+                }
+            }
+            float nk[3] = {0.0f, 0.0f, 0.0f};
+            nk[axis] = (d[axis] > 0.0f) ? -1.0f : 1.0f;
+            n = sgVec3(nk[0], nk[1], nk[2]);
+        }
+        else if (p.type == 3 && dir.y < 0.0f)
+        {
+            t = -origin.y / dir.y;
+        }
+
+        if (t > epsilon && t < best_t)
+        {
+            best_t = t;
+            best = i;
+            normal = n;
+        }
+    }
+
+    if (best < 0)
+    {
+        *color = sgVec3(0.0f, 0.0f, 0.0f);
+        return 1.0e30f;
+    }
+
+    const SgPrimitive& p = primitives[best];
+    SgVec3 hit = sgVec3(origin.x + best_t * dir.x, origin.y + best_t * dir.y, origin.z + best_t * dir.z);
+    if (p.type == 4)
+    {
+        // Sky gradient (unlit)
+        float k = 0.5f + 0.5f * dir.y;
+        *color = sgVec3(p.color.x * k + (1.0f - k), p.color.y * k + (1.0f - k), p.color.z * k + (1.0f - k));
+        return best_t;
+    }
+
+    // Lambert shading with 0.5m checker pattern (texture detail makes parallax errors visible)
+    const SgVec3 light = sgVec3(0.37f, 0.84f, 0.4f);
+    float lambert = std::max(normal.x * light.x + normal.y * light.y + normal.z * light.z, 0.0f);
+    int checker = ((int)floor(2.0f * hit.x + 1000.0f) + (int)floor(2.0f * hit.y + 1000.0f) +
+                   (int)floor(2.0f * hit.z + 1000.0f)) & 1;
+    float shade = (0.45f + 0.55f * lambert) * (checker ? 1.0f : 0.8f);
+    *color = sgVec3(shade * p.color.x, shade * p.color.y, shade * p.color.z);
+    return best_t;
+}
+
+static int sgWriteManifest(const SceneGenOptions& options, const std::vector<SgVec3>& positions)
+{
+    char filename[512];
+    snprintf(filename, 512, "%s/%s.json", options.output_dir.c_str(), options.name.c_str());
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", filename);
+        return 0;
+    }
+    fprintf(fp, "{\n");
+    fprintf(fp, "    \"name\": ");
+    jsonWriteString(fp, options.name);
+    fprintf(fp, ",\n");
+    fprintf(fp, "    \"format\": \"cdep\",\n");
+    fprintf(fp, "    \"num_views\": %d,\n", options.num_views);
+    fprintf(fp, "    \"max_views\": %d,\n", std::min(options.num_views, 8));
+    fprintf(fp, "    \"near\": 0.01,\n");
+    fprintf(fp, "    \"far\": 30.0,\n");
+    fprintf(fp, "    \"center\": [%.6f, %.6f, %.6f],\n", options.center[0], options.center[1], options.center[2]);
+    fprintf(fp, "    \"images\": [\n");
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        fprintf(fp, "        {\"file_prefix\": ");
+        jsonWriteString(fp, options.output_dir + "/" + options.name + "_camera_" + std::to_string(i + 1));
+        fprintf(fp, ", \"position\": [%.6f, %.6f, %.6f]}%s\n", positions[i].x, positions[i].y, positions[i].z,
+                (i + 1 < positions.size()) ? "," : "");
+    }
+    fprintf(fp, "    ]\n}\n");
+    fclose(fp);
+    return 1;
+}
+
+// Elliptical orbit inside view volume
+static int sgWriteCameraPath(const SceneGenOptions& options)
+{
+    char filename[512];
+    snprintf(filename, 512, "%s/%s_path.json", options.output_dir.c_str(), options.name.c_str());
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: could not open %s for writing\n", filename);
+        return 0;
+    }
+    int num_frames = 16;
+    fprintf(fp, "{\n");
+    fprintf(fp, "    \"origin\": [%.6f, %.6f, %.6f],\n", options.center[0], options.center[1], options.center[2]);
+    fprintf(fp, "    \"frames\": [\n");
+    for (int i = 0; i < num_frames; i++)
+    {
+        float angle = 2.0 * M_PI * i / num_frames;
+        fprintf(fp, "        {\"position\": [%.6f, %.6f, %.6f]}%s\n", 0.8f * options.view_extent[0] * cos(angle),
+                0.8f * options.view_extent[1] * sin(2.0f * angle), 0.8f * options.view_extent[2] * sin(angle),
+                (i + 1 < num_frames) ? "," : "");
+    }
+    fprintf(fp, "    ]\n}\n");
+    fclose(fp);
+    return 1;
+}
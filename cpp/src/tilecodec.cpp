@@ -0,0 +1,381 @@
+#include "tilecodec.h"
+
+#define TLZ_MIN_MATCH 4
+#define TLZ_LAST_LITERALS 5   // LZ4 block rules: sequences end with literals, last match starts 12 bytes before end
+#define TLZ_MATCH_LIMIT 12
+#define TLZ_HASH_BITS 14
+
+// Encodes 4 byte per pixel image as independently compressed tiles (tiles that do not shrink are stored raw)
+int tcEncodeImage(const uint8_t *pixels, int width, int height, TlzFormat format, int tile_size,
+                  std::vector<uint8_t> *output)
+{
+    TlzHeader header;
+    memcpy(header.magic, TLZ_MAGIC, 4);
+    header.version = TLZ_VERSION;
+    header.width = width;
+    header.height = height;
+    header.format = format;
+    header.tile_size = tile_size;
+    header.tiles_x = (width + tile_size - 1) / tile_size;
+    header.tiles_y = (height + tile_size - 1) / tile_size;
+    int num_tiles = header.tiles_x * header.tiles_y;
+
+    std::vector<TlzTile> tiles(num_tiles);
+    uint64_t table_size = sizeof(TlzHeader) + num_tiles * sizeof(TlzTile);
+    output->assign(table_size, 0);
+
+    std::vector<uint8_t> raw(tile_size * tile_size * 4);
+    std::vector<uint8_t> compressed(raw.size());
+    int i, y;
+    for (i = 0; i < num_tiles; i++)
+    {
+        int tx, ty, tw, th;
+        tcGetTileRect(header, i, &tx, &ty, &tw, &th);
+        int raw_size = tw * th * 4;
+        for (y = 0; y < th; y++)
+        {
+            memcpy(raw.data() + y * tw * 4, pixels + ((size_t)(ty + y) * width + tx) * 4, tw * 4);
+        }
+
+        // Capacity one byte short of raw size guarantees compressed and stored tiles can be told apart
+        int size = tcCompressBlock(raw.data(), raw_size, compressed.data(), raw_size - 1);
+        const uint8_t *payload = (size > 0) ? compressed.data() : raw.data();
+        tiles[i].offset = output->size();
+        tiles[i].size = (size > 0) ? size : raw_size;
+        tiles[i].reserved = 0;
+        tiles[i].value_range[0] = 0.0;
+        tiles[i].value_range[1] = 0.0;
+        if (format == TlzFormat::TLZ_FORMAT_R32F)
+        {
+            const float *values = reinterpret_cast<const float*>(raw.data());
+            tiles[i].value_range[0] = *std::min_element(values, values + tw * th);
+            tiles[i].value_range[1] = *std::max_element(values, values + tw * th);
+        }
+        output->insert(output->end(), payload, payload + tiles[i].size);
+    }
+    memcpy(output->data(), &header, sizeof(TlzHeader));
+    memcpy(output->data() + sizeof(TlzHeader), tiles.data(), num_tiles * sizeof(TlzTile));
+    return 1;
+}
+
+int tcReadHeader(const uint8_t *data, uint64_t size, TlzHeader *header)
+{
+    if (size < sizeof(TlzHeader))
+    {
+        return 0;
+    }
+    memcpy(header, data, sizeof(TlzHeader));
+    if (memcmp(header->magic, TLZ_MAGIC, 4) != 0 || header->version != TLZ_VERSION ||
+        header->format > TLZ_FORMAT_R32F || header->tile_size == 0 || header->tile_size > 4096 ||
+        header->tiles_x != (header->width + header->tile_size - 1) / header->tile_size ||
+        header->tiles_y != (header->height + header->tile_size - 1) / header->tile_size ||
+        sizeof(TlzHeader) + (uint64_t)header->tiles_x * header->tiles_y * sizeof(TlzTile) > size)
+    {
+        return 0;
+    }
+
+    // Tile table is bounds checked up front, so tile decodes only need to check compressed streams
+    uint32_t i;
+    const TlzTile *tiles = tcGetTiles(data);
+    for (i = 0; i < header->tiles_x * header->tiles_y; i++)
+    {
+        if (tiles[i].offset > size || tiles[i].size > size - tiles[i].offset)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Decodes tiles straight into `pixels` (width * height * 4 bytes) - tiles are split evenly among threads
+int tcDecodeImage(const uint8_t *data, uint64_t size, int num_threads, uint8_t *pixels)
+{
+    TlzHeader header;
+    if (!tcReadHeader(data, size, &header))
+    {
+        fprintf(stderr, "Error: not a valid version %d TLZ image\n", TLZ_VERSION);
+        return 0;
+    }
+
+    int t;
+    int num_tiles = header.tiles_x * header.tiles_y;
+    num_threads = std::max(std::min(num_threads, num_tiles), 1);
+    std::vector<std::thread> threads;
+    std::vector<int> success(num_threads, 1);
+    for (t = 0; t < num_threads; t++)
+    {
+        // Interleaved tiles balance threads when some tiles are stored raw and others compressed
+        threads.push_back(std::thread(tcDecodeTiles, data, std::cref(header), t, num_threads, pixels, &success[t]));
+    }
+    int all_success = 1;
+    for (t = 0; t < num_threads; t++)
+    {
+        threads[t].join();
+        all_success = all_success && success[t];
+    }
+    if (!all_success)
+    {
+        fprintf(stderr, "Error: TLZ image has corrupt tiles\n");
+    }
+    return all_success;
+}
+
+// Decodes one tile into `pixels` (tile width * tile height * 4 bytes) - header must come from tcReadHeader
+int tcDecodeTile(const uint8_t *data, const TlzHeader& header, int tile, uint8_t *pixels)
+{
+    int x, y, w, h;
+    tcGetTileRect(header, tile, &x, &y, &w, &h);
+    const TlzTile& info = tcGetTiles(data)[tile];
+    if ((int)info.size == w * h * 4)
+    {
+        memcpy(pixels, data + info.offset, info.size);
+        return 1;
+    }
+    return tcDecompressBlock(data + info.offset, info.size, pixels, w * h * 4);
+}
+
+const TlzTile* tcGetTiles(const uint8_t *data)
+{
+    return reinterpret_cast<const TlzTile*>(data + sizeof(TlzHeader));
+}
+
+void tcGetTileRect(const TlzHeader& header, int tile, int *x, int *y, int *w, int *h)
+{
+    *x = (tile % header.tiles_x) * header.tile_size;
+    *y = (tile / header.tiles_x) * header.tile_size;
+    *w = std::min(header.tile_size, header.width - *x);
+    *h = std::min(header.tile_size, header.height - *y);
+}
+
+// Returns malloc'd pixels (4 bytes each), or NULL
+uint8_t* tcReadImage(const char *filename, int num_threads, int *width, int *height, TlzFormat *format)
+{
+    char *data;
+    int size = iioReadFile(filename, &data);
+    TlzHeader header;
+    if (data == NULL || !tcReadHeader((uint8_t*)data, size, &header))
+    {
+        fprintf(stderr, "Error: %s is not a version %d TLZ image\n", filename, TLZ_VERSION);
+        free(data);
+        return NULL;
+    }
+
+    uint8_t *pixels = (uint8_t*)malloc((size_t)header.width * header.height * 4);
+    if (pixels == NULL)
+    {
+        fprintf(stderr, "Error: cannot allocate %ux%u image for %s\n", header.width, header.height, filename);
+        free(data);
+        return NULL;
+    }
+    if (!tcDecodeImage((uint8_t*)data, size, num_threads, pixels))
+    {
+        free(data);
+        free(pixels);
+        return NULL;
+    }
+    free(data);
+    *width = header.width;
+    *height = header.height;
+    *format = (TlzFormat)header.format;
+    return pixels;
+}
+
+
+// Private
+static void tcDecodeTiles(const uint8_t *data, const TlzHeader& header, int first_tile, int tile_stride,
+                          uint8_t *pixels, int *success)
+{
+    const TlzTile *tiles = tcGetTiles(data);
+    std::vector<uint8_t> raw(header.tile_size * header.tile_size * 4);
+    int i, y;
+    int num_tiles = header.tiles_x * header.tiles_y;
+    for (i = first_tile; i < num_tiles; i += tile_stride)
+    {
+        int tx, ty, tw, th;
+        tcGetTileRect(header, i, &tx, &ty, &tw, &th);
+        int raw_size = tw * th * 4;
+        const uint8_t *tile = data + tiles[i].offset;
+        if ((int)tiles[i].size != raw_size)
+        {
+            if (!tcDecompressBlock(tile, tiles[i].size, raw.data(), raw_size))
+            {
+                *success = 0;
+                return;
+            }
+            tile = raw.data();
+        }
+        for (y = 0; y < th; y++)
+        {
+            memcpy(pixels + ((size_t)(ty + y) * header.width + tx) * 4, tile + y * tw * 4, tw * 4);
+        }
+    }
+}
+
+// LZ4 block format (greedy matching) - returns compressed size, or 0 if output would not fit
+static int tcCompressBlock(const uint8_t *src, int src_size, uint8_t *dst, int dst_capacity)
+{
+    std::vector<uint32_t> table(1 << TLZ_HASH_BITS, 0); // position + 1 of last occurrence (0 is empty)
+    int ip = 0;
+    int op = 0;
+    int anchor = 0;
+    int match_limit = src_size - TLZ_MATCH_LIMIT;
+    while (ip < match_limit)
+    {
+        uint32_t sequence;
+        memcpy(&sequence, src + ip, 4);
+        uint32_t hash = (sequence * 2654435761U) >> (32 - TLZ_HASH_BITS);
+        int ref = (int)table[hash] - 1;
+        table[hash] = ip + 1;
+        if (ref < 0 || ip - ref > 65535 || memcmp(src + ref, src + ip, 4) != 0)
+        {
+            // Skip ahead faster through incompressible data
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+        }
+
+        // Extend match backwards into pending literals, then forwards
+        while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1])
+        {
+            ip--;
+            ref--;
+        }
+        int length = TLZ_MIN_MATCH;
+        while (ip + length < src_size - TLZ_LAST_LITERALS && src[ip + length] == src[ref + length])
+        {
+            length++;
+        }
+
+        int literals = ip - anchor;
+        if (op + 1 + literals / 255 + 1 + literals + 2 + (length - TLZ_MIN_MATCH) / 255 + 1 > dst_capacity)
+        {
+            return 0;
+        }
+        uint8_t *token = dst + op++;
+        *token = (std::min(literals, 15) << 4) | std::min(length - TLZ_MIN_MATCH, 15);
+        int remaining;
+        if (literals >= 15)
+        {
+            for (remaining = literals - 15; remaining >= 255; remaining -= 255)
+            {
+                dst[op++] = 255;
+            }
+            dst[op++] = remaining;
+        }
+        memcpy(dst + op, src + anchor, literals);
+        op += literals;
+        dst[op++] = (ip - ref) & 0xFF;
+        dst[op++] = (ip - ref) >> 8;
+        if (length - TLZ_MIN_MATCH >= 15)
+        {
+            for (remaining = length - TLZ_MIN_MATCH - 15; remaining >= 255; remaining -= 255)
+            {
+                dst[op++] = 255;
+            }
+            dst[op++] = remaining;
+        }
+        ip += length;
+        anchor = ip;
+    }
+
+    // Final literals
+    int literals = src_size - anchor;
+    if (op + 1 + literals / 255 + 1 + literals > dst_capacity)
+    {
+        return 0;
+    }
+    dst[op++] = std::min(literals, 15) << 4;
+    if (literals >= 15)
+    {
+        int remaining;
+        for (remaining = literals - 15; remaining >= 255; remaining -= 255)
+        {
+            dst[op++] = 255;
+        }
+        dst[op++] = remaining;
+    }
+    memcpy(dst + op, src + anchor, literals);
+    op += literals;
+    return op;
+}
+
+// Bounds checked LZ4 block decode - returns 1 only if output is exactly `dst_size` bytes
+static int tcDecompressBlock(const uint8_t *src, int src_size, uint8_t *dst, int dst_size)
+{
+    int ip = 0;
+    int op = 0;
+    while (ip < src_size)
+    {
+        uint8_t token = src[ip++];
+        int literals = token >> 4;
+        if (literals == 15)
+        {
+            uint8_t extra;
+            do
+            {
+                if (ip >= src_size)
+                {
+                    return 0;
+                }
+                extra = src[ip++];
+                literals += extra;
+            } while (extra == 255);
+        }
+        if (literals > src_size - ip || literals > dst_size - op)
+        {
+            return 0;
+        }
+        memcpy(dst + op, src + ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == src_size)
+        {
+            break;
+        }
+
+        if (ip + 2 > src_size)
+        {
+            return 0;
+        }
+        int offset = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        int length = token & 0x0F;
+        if (length == 15)
+        {
+            uint8_t extra;
+            do
+            {
+                if (ip >= src_size)
+                {
+                    return 0;
+                }
+                extra = src[ip++];
+                length += extra;
+            } while (extra == 255);
+        }
+        length += TLZ_MIN_MATCH;
+        if (offset == 0 || offset > op || length > dst_size - op)
+        {
+            return 0;
+        }
+
+        // Overlapping matches (runs of repeated pixels) are copied in doubling chunks of whole periods
+        uint8_t *out = dst + op;
+        if (offset >= length)
+        {
+            memcpy(out, out - offset, length);
+        }
+        else
+        {
+            memcpy(out, out - offset, offset);
+            int copied = offset;
+            while (copied < length)
+            {
+                int chunk = std::min(copied, length - copied);
+                memcpy(out + copied, out, chunk);
+                copied += chunk;
+            }
+        }
+        op += length;
+    }
+    return op == dst_size;
+}
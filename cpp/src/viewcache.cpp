@@ -0,0 +1,114 @@
+#include "viewcache.h"
+
+// Maps cached texture-ready view (a single view archive) keyed by hash of image's color and depth files. On a miss the
+// image is decoded once and its entry written, so later launches skip PNG / RVL decode. If entry cannot be written,
+// decoded image is handed back instead (color is NULL otherwise - caller frees color and depth like scnReadImage's)
+int vcOpenView(const char *cache_dir, bool compress, const SceneManifest& scene, int image, int num_threads,
+               OdsArchive *entry, uint8_t **color, float **depth, int *width, int *height)
+{
+    *color = NULL;
+    *depth = NULL;
+    std::string color_filename, depth_filename;
+    scnGetImageFilenames(scene, image, &color_filename, &depth_filename);
+
+    // FNV-1a over file contents, then encodings and storage options (changing any of them is a different entry)
+    uint64_t hash = 14695981039346656037ULL;
+    if (!vcHashFile(color_filename.c_str(), &hash) || !vcHashFile(depth_filename.c_str(), &hash))
+    {
+        return 0;
+    }
+    uint32_t options[4] = {VIEW_CACHE_VERSION, (uint32_t)scene.color_encoding, (uint32_t)scene.depth_encoding,
+                           (uint32_t)compress};
+    int i;
+    for (i = 0; i < 16; i++)
+    {
+        hash = (hash ^ ((uint8_t*)options)[i]) * 1099511628211ULL;
+    }
+    char entry_name[32];
+    snprintf(entry_name, 32, "/%016llx.cdepa", (unsigned long long)hash);
+    std::string entry_filename = std::string(cache_dir) + entry_name;
+
+    FILE *fp = fopen(entry_filename.c_str(), "rb");
+    if (fp == NULL)
+    {
+        if (!scnReadImage(scene, image, num_threads, color, depth, width, height))
+        {
+            *color = NULL;
+            *depth = NULL;
+            return 0;
+        }
+
+        // Written under temporary name, so an interrupted write never leaves a truncated entry
+        std::string temp_filename = entry_filename + ".tmp";
+        OdsArchiveWriter writer;
+        int success = vcMakeDirectories(cache_dir) && oaBeginArchive(temp_filename.c_str(), 1, &writer);
+        if (success)
+        {
+            success = oaAddView(&writer, scene.images[image].position, *width, *height, *color, *depth, compress);
+            success = oaFinishArchive(&writer) && success;
+            success = success && rename(temp_filename.c_str(), entry_filename.c_str()) == 0;
+            if (!success)
+            {
+                remove(temp_filename.c_str());
+            }
+        }
+        if (!success)
+        {
+            fprintf(stderr, "Warning: could not write view cache entry %s\n", entry_filename.c_str());
+            return 1;
+        }
+        iioFreeImage(*color);
+        free(*depth);
+        *color = NULL;
+        *depth = NULL;
+    }
+    else
+    {
+        fclose(fp);
+    }
+    return oaOpenArchive(entry_filename.c_str(), entry);
+}
+
+
+// Private
+static int vcHashFile(const char *filename, uint64_t *hash)
+{
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: cannot open %s\n", filename);
+        return 0;
+    }
+    std::vector<uint8_t> buffer(1 << 20);
+    size_t i, count;
+    uint64_t h = *hash;
+    while ((count = fread(buffer.data(), 1, buffer.size(), fp)) > 0)
+    {
+        for (i = 0; i < count; i++)
+        {
+            h = (h ^ buffer[i]) * 1099511628211ULL;
+        }
+    }
+    fclose(fp);
+    *hash = h;
+    return 1;
+}
+
+static int vcMakeDirectories(const std::string& path)
+{
+    size_t i;
+    for (i = 1; i <= path.size(); i++)
+    {
+        if (i == path.size() || path[i] == '/' || path[i] == '\\')
+        {
+            std::string directory = path.substr(0, i);
+#ifdef _WIN32
+            _mkdir(directory.c_str());
+#else
+            mkdir(directory.c_str(), 0755);
+#endif
+        }
+    }
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFDIR);
+}